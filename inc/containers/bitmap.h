@@ -0,0 +1,57 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <bit>
+
+namespace ecs {
+	// one bit per key, words are read directly to test 64 keys at once
+	class bitmap {
+	public:
+		using word_type = std::uint64_t;
+		static constexpr std::size_t word_width = sizeof(word_type) * 8;
+
+		[[nodiscard]] static constexpr std::size_t word_index(std::size_t key) noexcept { return key / word_width; }
+		[[nodiscard]] static constexpr word_type bit(std::size_t key) noexcept { return word_type{ 1 } << (key % word_width); }
+
+		[[nodiscard]] constexpr bool test(std::size_t key) const noexcept {
+			return word(word_index(key)) & bit(key);
+		}
+
+		/* returns the word holding the bits of the keys [word_i * word_width, (word_i + 1) * word_width), words past the end are empty. */
+		[[nodiscard]] constexpr word_type word(std::size_t word_i) const noexcept {
+			return word_i < words.size() ? words[word_i] : 0;
+		}
+
+		constexpr void set(std::size_t key) {
+			std::size_t word_i = word_index(key);
+			if (word_i >= words.size()) {
+				words.resize(std::bit_ceil(word_i + 1));
+			}
+			words[word_i] |= bit(key);
+		}
+
+		constexpr void reset(std::size_t key) noexcept {
+			if (std::size_t word_i = word_index(key); word_i < words.size()) {
+				words[word_i] &= ~bit(key);
+			}
+		}
+
+		/* returns the number of set bits. */
+		[[nodiscard]] constexpr std::size_t count() const noexcept {
+			std::size_t n = 0;
+			for (word_type w : words) n += std::popcount(w);
+			return n;
+		}
+
+		[[nodiscard]] constexpr std::size_t word_count() const noexcept { return words.size(); }
+
+		constexpr void clear() noexcept { words.clear(); }
+		constexpr void shrink_to_fit() {
+			while (!words.empty() && words.back() == 0) words.pop_back();
+			words.shrink_to_fit();
+		}
+
+	private:
+		std::vector<word_type> words;
+	};
+}
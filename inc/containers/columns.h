@@ -0,0 +1,335 @@
+#pragma once
+#include "containers/packed.h"
+#include <tuple>
+#include <utility>
+#include <iterator>
+#include <type_traits>
+#include <ranges>
+/*
+column storage. decomposes an aggregate value type into its members and 
+stores each member in its own packed column, accessing an element returns 
+a proxy tuple of references to the members. an aggregate may have at most 
+16 members, and members must not be arrays or references. a std::tuple is 
+decomposed into its elements.
+*/
+
+namespace ecs::details {
+	struct any_member { 
+		template<typename T> constexpr operator T() const; 
+	};
+
+	/* returns the number of members of an aggregate. */
+	template<typename T, typename ... Ts>
+	consteval std::size_t aggregate_arity() {
+		if constexpr (requires { T{ Ts{}..., any_member{} }; }) {
+			return aggregate_arity<T, Ts..., any_member>();
+		} else {
+			return sizeof...(Ts);
+		}
+	}
+
+	/* returns a tuple of references to the members of an aggregate. */
+	template<typename T>
+	constexpr auto tie_members(T& value) {
+		constexpr std::size_t arity = aggregate_arity<std::remove_const_t<T>>();
+		static_assert(arity != 0 && arity <= 16, "column storage requires an aggregate of 1 to 16 members.");
+
+		if constexpr (arity == 16) {
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15] = value;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15);
+		} else if constexpr (arity == 15) {
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14] = value;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14);
+		} else if constexpr (arity == 14) {
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13] = value;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13);
+		} else if constexpr (arity == 13) {
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12] = value;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12);
+		} else if constexpr (arity == 12) {
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11] = value;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11);
+		} else if constexpr (arity == 11) {
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10] = value;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10);
+		} else if constexpr (arity == 10) {
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9] = value;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9);
+		} else if constexpr (arity == 9) {
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8] = value;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8);
+		} else if constexpr (arity == 8) {
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7] = value;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7);
+		} else if constexpr (arity == 7) {
+			auto& [m0, m1, m2, m3, m4, m5, m6] = value;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6);
+		} else if constexpr (arity == 6) {
+			auto& [m0, m1, m2, m3, m4, m5] = value;
+			return std::tie(m0, m1, m2, m3, m4, m5);
+		} else if constexpr (arity == 5) {
+			auto& [m0, m1, m2, m3, m4] = value;
+			return std::tie(m0, m1, m2, m3, m4);
+		} else if constexpr (arity == 4) {
+			auto& [m0, m1, m2, m3] = value;
+			return std::tie(m0, m1, m2, m3);
+		} else if constexpr (arity == 3) {
+			auto& [m0, m1, m2] = value;
+			return std::tie(m0, m1, m2);
+		} else if constexpr (arity == 2) {
+			auto& [m0, m1] = value;
+			return std::tie(m0, m1);
+		} else if constexpr (arity == 1) {
+			auto& [m0] = value;
+			return std::tie(m0);
+		}
+	}
+
+	/* returns a tuple of references to the elements of a tuple. */
+	template<typename ... Ts>
+	constexpr auto tie_members(std::tuple<Ts...>& value) {
+		return std::apply([](auto& ... elems) { return std::tie(elems...); }, value);
+	}
+
+	/* returns a tuple of references to the elements of a tuple. */
+	template<typename ... Ts>
+	constexpr auto tie_members(const std::tuple<Ts...>& value) {
+		return std::apply([](auto& ... elems) { return std::tie(elems...); }, value);
+	}
+
+	template<typename T> struct member_types;
+	template<typename ... Ts> struct member_types<std::tuple<Ts&...>> { using type = std::tuple<Ts...>; };
+	template<typename T> using member_types_t = typename member_types<decltype(tie_members(std::declval<T&>()))>::type;
+}
+
+namespace ecs {
+	template<typename T, std::size_t N=4096, typename member_Ts=details::member_types_t<T>>
+	class columns;
+
+	template<typename base_T>
+	class columns_iterator;
+	
+	template<typename T, typename ... Ts>
+	struct column_reference : std::tuple<Ts&...> {
+		using base_type = std::tuple<Ts&...>;
+		using base_type::base_type;
+
+		constexpr column_reference(const column_reference& other) = default;
+
+		constexpr const column_reference& operator=(const column_reference& other) const {
+			assign(other, std::index_sequence_for<Ts...>{});
+			return *this;
+		}
+
+		constexpr const column_reference& operator=(column_reference&& other) const {
+			assign_move(other, std::index_sequence_for<Ts...>{}); // the members of other are lvalue references, moved explicitly
+			return *this;
+		}
+
+		constexpr const column_reference& operator=(const T& value) const {
+			assign(details::tie_members(value), std::index_sequence_for<Ts...>{});
+			return *this;
+		}
+
+		constexpr const column_reference& operator=(T&& value) const {
+			assign_move(details::tie_members(value), std::index_sequence_for<Ts...>{});
+			return *this;
+		}
+
+		constexpr operator T() const {
+			return std::apply([](auto& ... members) { return T{ members... }; }, static_cast<const base_type&>(*this));
+		}
+
+		/** swaps the referenced members, proxies are swapped as prvalues by std::rotate and std::iter_swap */
+		friend constexpr void swap(const column_reference& lhs, const column_reference& rhs) {
+			[&]<std::size_t ... Is>(std::index_sequence<Is...>) {
+				(std::ranges::swap(std::get<Is>(lhs), std::get<Is>(rhs)), ...);
+			}(std::index_sequence_for<Ts...>{});
+		}
+
+	private:
+		template<typename tup_T, std::size_t ... Is>
+		constexpr void assign(tup_T&& other, std::index_sequence<Is...>) const {
+			((std::get<Is>(*this) = std::get<Is>(std::forward<tup_T>(other))), ...);
+		}
+
+		template<typename tup_T, std::size_t ... Is>
+		constexpr void assign_move(tup_T&& other, std::index_sequence<Is...>) const {
+			((std::get<Is>(*this) = std::move(std::get<Is>(other))), ...);
+		}
+	};
+
+	template<typename T, std::size_t N, typename ... Ts>
+	class columns<T, N, std::tuple<Ts...>> {
+		template<typename> friend class columns_iterator;
+	public:
+		using value_type = T;
+		using reference = column_reference<T, Ts...>;
+		using const_reference = column_reference<T, const Ts...>;
+		using iterator = columns_iterator<columns>;
+		using const_iterator = columns_iterator<const columns>;
+		using data_type = std::tuple<ecs::packed<Ts, N>...>;
+		static constexpr std::size_t page_size = N;
+
+	public:
+		constexpr iterator begin() noexcept { return { this, 0 }; }
+		constexpr const_iterator begin() const noexcept { return { this, 0 }; }
+		constexpr iterator end() noexcept { return { this, size() }; }
+		constexpr const_iterator end() const noexcept { return { this, size() }; }
+		constexpr const_iterator cbegin() const noexcept { return { this, 0 }; }
+		constexpr const_iterator cend() const noexcept { return { this, size() }; }
+
+		[[nodiscard]] constexpr bool empty() const noexcept { return std::get<0>(data).empty(); }
+		constexpr std::size_t size() const { return std::get<0>(data).size(); }
+		constexpr std::size_t capacity() const { return std::get<0>(data).capacity(); }
+		constexpr void resize(std::size_t n) { std::apply([&](auto& ... cols) { (cols.resize(n), ...); }, data); }
+		constexpr void reserve(std::size_t n) { std::apply([&](auto& ... cols) { (cols.reserve(n), ...); }, data); }
+		constexpr void shrink_to_fit() { std::apply([&](auto& ... cols) { (cols.shrink_to_fit(), ...); }, data); }
+		constexpr void clear() noexcept { std::apply([&](auto& ... cols) { (cols.clear(), ...); }, data); }
+
+		constexpr reference operator[](std::size_t pos) { return std::apply([&](auto& ... cols) { return reference{ cols[pos]... }; }, data); }
+		constexpr const_reference operator[](std::size_t pos) const { return std::apply([&](auto& ... cols) { return const_reference{ cols[pos]... }; }, data); }
+		constexpr reference at(std::size_t pos) { return std::apply([&](auto& ... cols) { return reference{ cols.at(pos)... }; }, data); }
+		constexpr const_reference at(std::size_t pos) const { return std::apply([&](auto& ... cols) { return const_reference{ cols.at(pos)... }; }, data); }
+		constexpr reference front() { return at(0); }
+		constexpr const_reference front() const { return at(0); }
+		constexpr reference back() { return at(size() - 1); }
+		constexpr const_reference back() const { return at(size() - 1); }
+
+		/** returns the packed column storing the I-th member of each value */
+		template<std::size_t I> constexpr auto& column() noexcept { return std::get<I>(data); }
+		template<std::size_t I> constexpr const auto& column() const noexcept { return std::get<I>(data); }
+
+		/** returns the packed column storing the member of type U, U must be unique among the members */
+		template<typename U> constexpr auto& column() noexcept { return std::get<ecs::packed<U, N>>(data); }
+		template<typename U> constexpr const auto& column() const noexcept { return std::get<ecs::packed<U, N>>(data); }
+
+		template<typename ... arg_Ts>
+		constexpr reference emplace_back(arg_Ts&& ... args) {
+			if constexpr (sizeof...(arg_Ts) == 1 && (std::is_same_v<std::remove_cvref_t<arg_Ts>, reference> && ...)) {
+				emplace_members(std::forward<arg_Ts>(args)..., std::index_sequence_for<Ts...>{});
+			} else {
+				T value(std::forward<arg_Ts>(args)...);
+				emplace_members(details::tie_members(value), std::index_sequence_for<Ts...>{});
+			}
+			return back();
+		}
+
+		template<std::ranges::input_range R>
+		constexpr void append_range(R&& rg) {
+			if constexpr (std::ranges::sized_range<R>) {
+				reserve(size() + std::ranges::size(rg));
+			}
+
+			constexpr bool movable = !std::is_lvalue_reference_v<R> && !std::ranges::view<std::remove_cvref_t<R>>;
+			for (auto&& value : rg) {
+				if constexpr (movable) {
+					emplace_back(std::move(value));
+				} else {
+					emplace_back(std::forward<decltype(value)>(value));
+				}
+			}
+		}
+
+		template<std::ranges::input_range R>
+		constexpr iterator insert_range(const_iterator pos, R&& rg) {
+			std::size_t idx = pos - cbegin();
+			std::size_t count = size();
+			append_range(std::forward<R>(rg));
+			std::apply([&](auto& ... cols) { (std::rotate(cols.begin() + idx, cols.begin() + count, cols.end()), ...); }, data);
+			return begin() + idx;
+		}
+
+		template<typename ... arg_Ts>
+		constexpr iterator emplace(const_iterator pos, arg_Ts&& ... args) {
+			std::size_t idx = pos - cbegin();
+			T value(std::forward<arg_Ts>(args)...);
+			[&]<std::size_t ... Is>(std::index_sequence<Is...>) {
+				auto members = details::tie_members(value);
+				(std::get<Is>(data).emplace(std::get<Is>(data).cbegin() + idx, std::move(std::get<Is>(members))), ...);
+			}(std::index_sequence_for<Ts...>{});
+			return begin() + idx;
+		}
+
+		constexpr iterator erase(const_iterator pos) {
+			std::size_t idx = pos - cbegin();
+			std::apply([&](auto& ... cols) { (cols.erase(cols.cbegin() + idx), ...); }, data);
+			return begin() + idx;
+		}
+
+		constexpr iterator erase(const_iterator first, const_iterator last) {
+			std::size_t idx = first - cbegin();
+			std::size_t n = last - first;
+			std::apply([&](auto& ... cols) { (cols.erase(cols.cbegin() + idx, cols.cbegin() + idx + n), ...); }, data);
+			return begin() + idx;
+		}
+
+		/** moves n values from src to dst with a page-wise memmove of each column, available when every member is trivially copyable */
+		constexpr void relocate(std::size_t dst, std::size_t src, std::size_t n) requires (std::is_trivially_copyable_v<Ts> && ...) {
+			std::apply([&](auto& ... cols) { (cols.relocate(dst, src, n), ...); }, data);
+		}
+
+	private:
+		template<typename tup_T, std::size_t ... Is>
+		constexpr void emplace_members(tup_T&& members, std::index_sequence<Is...>) {
+			(std::get<Is>(data).emplace_back(std::move(std::get<Is>(members))), ...);
+		}
+
+		data_type data;
+	};
+
+	template<typename base_T>
+	class columns_iterator {
+	public:
+		using value_type = typename std::remove_const_t<base_T>::value_type;
+		using reference = std::conditional_t<std::is_const_v<base_T>, typename base_T::const_reference, typename base_T::reference>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using iterator_category = std::random_access_iterator_tag;
+
+	public:
+		constexpr columns_iterator() : range(nullptr), index(-1) { }
+		constexpr columns_iterator(base_T* range, std::size_t index) : range(range), index(index) { }
+		constexpr operator columns_iterator<const base_T>() const { return { range, index }; }
+
+		constexpr reference operator*() const { return (*range)[index]; }
+		constexpr reference operator[](difference_type n) const { return (*range)[index + n]; }
+
+		constexpr columns_iterator& operator++() { ++index; return *this; }
+		constexpr columns_iterator operator++(int) { auto tmp = *this; ++index; return tmp; }
+		constexpr columns_iterator& operator--() { --index; return *this; }
+		constexpr columns_iterator operator--(int) { auto tmp = *this; --index; return tmp; }
+		constexpr columns_iterator& operator+=(difference_type n) { index += n; return *this; }
+		constexpr columns_iterator& operator-=(difference_type n) { index -= n; return *this; }
+		constexpr columns_iterator operator+(difference_type n) const { return { range, index + n }; }
+		constexpr columns_iterator operator-(difference_type n) const { return { range, index - n }; }
+		constexpr difference_type operator-(const columns_iterator& other) const { return index - other.index; }
+		friend constexpr columns_iterator operator+(difference_type n, const columns_iterator& it) { return it + n; }
+
+		friend constexpr auto operator<=>(const columns_iterator& lhs, const columns_iterator& rhs) { return lhs.index <=> rhs.index; }
+		friend constexpr bool operator==(const columns_iterator& lhs, const columns_iterator& rhs) { return lhs.index == rhs.index; }
+
+		friend constexpr void iter_swap(const columns_iterator& lhs, const columns_iterator& rhs) {
+			swap(*lhs, *rhs);
+		}
+
+		/** returns the value with its members moved out of the columns */
+		friend constexpr value_type iter_move(const columns_iterator& it) {
+			return std::apply([](auto& ... members) { return value_type{ std::move(members)... }; }, static_cast<typename reference::base_type>(*it));
+		}
+
+		constexpr std::size_t get_index() const { return index; }
+
+	private:
+		base_T* range;
+		std::size_t index;
+	};
+}
+
+namespace std {
+	template<typename T, typename ... Ts>
+	struct tuple_size<ecs::column_reference<T, Ts...>> : std::integral_constant<std::size_t, sizeof...(Ts)> { };
+
+	template<std::size_t I, typename T, typename ... Ts>
+	struct tuple_element<I, ecs::column_reference<T, Ts...>> : tuple_element<I, std::tuple<Ts&...>> { };
+}
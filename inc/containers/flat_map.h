@@ -0,0 +1,251 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <bit>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+/*
+open addressing hash table. slots are stored inline in a single array
+probed linearly, a parallel array of control bytes holds a 7 bit hash
+fingerprint of each occupied slot and 0 for an empty slot. a probe reads
+8 control bytes as one word and matches the fingerprint against all of
+them at once, keys are only compared for matching bytes. erasing shifts
+the following displaced slots back instead of leaving a tombstone, so
+probe lengths do not degrade under churn. the first 8 control bytes are
+mirrored past the end so a group never wraps.
+*/
+
+namespace ecs::details {
+	template<typename value_T, typename key_T, typename hash_T, typename eq_T>
+	class flat_table {
+		using word_type = std::uint64_t;
+		using ctrl_type = std::uint8_t;
+		static constexpr std::size_t group_width = sizeof(word_type);
+		static constexpr std::size_t min_capacity = 16;
+		static constexpr ctrl_type empty_ctrl = 0;
+		static constexpr word_type lsb = 0x0101010101010101ull;
+		static constexpr word_type msb = 0x8080808080808080ull;
+
+	public:
+		using key_type = key_T;
+		using value_type = value_T;
+		using size_type = std::size_t;
+		using hasher = hash_T;
+		using key_equal = eq_T;
+		using iterator = value_type*;
+		using const_iterator = const value_type*;
+
+		[[nodiscard]] constexpr std::size_t size() const noexcept { return count; }
+		[[nodiscard]] constexpr bool empty() const noexcept { return count == 0; }
+		[[nodiscard]] constexpr std::size_t capacity() const noexcept { return slots.size(); }
+
+		constexpr iterator end() noexcept { return nullptr; }
+		constexpr const_iterator end() const noexcept { return nullptr; }
+		constexpr const_iterator cend() const noexcept { return nullptr; }
+
+		[[nodiscard]] constexpr iterator find(const key_type& key) {
+			std::size_t slot_i = lookup(key);
+			return slot_i != npos ? &slots[slot_i] : end();
+		}
+		[[nodiscard]] constexpr const_iterator find(const key_type& key) const {
+			std::size_t slot_i = lookup(key);
+			return slot_i != npos ? &slots[slot_i] : end();
+		}
+
+		[[nodiscard]] constexpr bool contains(const key_type& key) const { return lookup(key) != npos; }
+
+		/* inserts the value if its key is absent, returns the slot of the key and true if inserted. */
+		template<typename ... arg_Ts>
+		constexpr std::pair<iterator, bool> emplace(arg_Ts&&... args) {
+			value_type value(std::forward<arg_Ts>(args)...);
+			const key_type& key = key_of(value);
+			std::size_t hash = mix(key);
+
+			if (std::size_t slot_i = lookup(key, hash); slot_i != npos) {
+				return { &slots[slot_i], false };
+			}
+
+			if ((count + 1) * 8 > capacity() * 7) { // max load factor 7/8
+				rehash(std::max(min_capacity, capacity() * 2));
+			}
+
+			std::size_t slot_i = insert_slot(hash);
+			slots[slot_i] = std::move(value);
+			set_ctrl(slot_i, fingerprint(hash));
+			++count;
+			return { &slots[slot_i], true };
+		}
+
+		/* erases the key, the displaced slots following it are shifted back to close the gap. returns the number of erased keys. */
+		constexpr std::size_t erase(const key_type& key) {
+			std::size_t hole = lookup(key);
+			if (hole == npos) return 0;
+
+			std::size_t mask = capacity() - 1;
+			for (std::size_t slot_i = (hole + 1) & mask; ctrls[slot_i] != empty_ctrl; slot_i = (slot_i + 1) & mask) {
+				std::size_t home = mix(key_of(slots[slot_i])) & mask;
+				if (((slot_i - home) & mask) >= ((slot_i - hole) & mask)) { // the hole lies on the probe path of the slot
+					slots[hole] = std::move(slots[slot_i]);
+					set_ctrl(hole, ctrls[slot_i]);
+					hole = slot_i;
+				}
+			}
+
+			if constexpr (!std::is_trivially_destructible_v<value_type>) {
+				slots[hole] = value_type{ }; // releases the resources held by the erased value
+			}
+			set_ctrl(hole, empty_ctrl);
+			--count;
+			return 1;
+		}
+
+		constexpr void clear() noexcept {
+			if (count == 0) return;
+
+			if constexpr (!std::is_trivially_destructible_v<value_type>) {
+				std::fill(slots.begin(), slots.end(), value_type{ });
+			}
+			std::fill(ctrls.begin(), ctrls.end(), empty_ctrl);
+			count = 0;
+		}
+
+		constexpr void reserve(std::size_t n) {
+			std::size_t required = std::bit_ceil(std::max(min_capacity, (n * 8 + 6) / 7));
+			if (required > capacity()) rehash(required);
+		}
+
+		constexpr void shrink_to_fit() {
+			if (count == 0) {
+				slots = { };
+				ctrls = { };
+			} else {
+				std::size_t required = std::bit_ceil(std::max(min_capacity, (count * 8 + 6) / 7));
+				if (required < capacity()) rehash(required);
+			}
+		}
+
+	private:
+		static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+		static constexpr const key_type& key_of(const value_type& value) noexcept {
+			if constexpr (std::is_same_v<value_type, key_type>) {
+				return value;
+			} else {
+				return value.first;
+			}
+		}
+
+		/* applies the murmur3 finalizer so every input bit affects every output bit, the low bits select the slot and the high bits the fingerprint. strided keys sharing their low bits would otherwise share a home group. */
+		static constexpr std::size_t mix(const key_type& key) {
+			word_type hash = static_cast<word_type>(hasher{ }(key));
+			hash ^= hash >> 33;
+			hash *= 0xFF51AFD7ED558CCDull;
+			hash ^= hash >> 33;
+			hash *= 0xC4CEB9FE1A85EC53ull;
+			hash ^= hash >> 33;
+			return static_cast<std::size_t>(hash);
+		}
+
+		static constexpr ctrl_type fingerprint(std::size_t hash) noexcept {
+			return static_cast<ctrl_type>(0x80 | (static_cast<word_type>(hash) >> 57));
+		}
+
+		/* reads the 8 control bytes from the slot, byte i of the group is held in bits [8i, 8i + 8). */
+		constexpr word_type load_group(std::size_t slot_i) const noexcept {
+			word_type group;
+			std::memcpy(&group, ctrls.data() + slot_i, sizeof(group));
+			if constexpr (std::endian::native == std::endian::big) {
+				group = std::byteswap(group);
+			}
+			return group;
+		}
+
+		/* returns the high bit of each byte equal to ctrl, bytes past a true match may be reported falsely and are verified by the caller. */
+		static constexpr word_type match(word_type group, ctrl_type ctrl) noexcept {
+			word_type x = group ^ (lsb * ctrl);
+			return (x - lsb) & ~x & msb;
+		}
+
+		static constexpr word_type match_empty(word_type group) noexcept {
+			return ~group & msb; // occupied bytes have the high bit set
+		}
+
+		constexpr std::size_t lookup(const key_type& key) const { return lookup(key, mix(key)); }
+
+		constexpr std::size_t lookup(const key_type& key, std::size_t hash) const {
+			if (count == 0) return npos;
+
+			std::size_t mask = capacity() - 1;
+			ctrl_type ctrl = fingerprint(hash);
+			for (std::size_t pos = hash & mask; ; pos = (pos + group_width) & mask) {
+				word_type group = load_group(pos);
+				for (word_type bits = match(group, ctrl); bits != 0; bits &= bits - 1) {
+					std::size_t slot_i = (pos + std::countr_zero(bits) / 8) & mask;
+					if (key_equal{ }(key_of(slots[slot_i]), key)) return slot_i;
+				}
+				if (match_empty(group) != 0) return npos; // the key would precede the first empty slot
+			}
+		}
+
+		/* returns the first empty slot on the probe path of the hash, the table is never full. */
+		constexpr std::size_t insert_slot(std::size_t hash) const noexcept {
+			std::size_t mask = capacity() - 1;
+			for (std::size_t pos = hash & mask; ; pos = (pos + group_width) & mask) {
+				if (word_type bits = match_empty(load_group(pos)); bits != 0) {
+					return (pos + std::countr_zero(bits) / 8) & mask;
+				}
+			}
+		}
+
+		constexpr void set_ctrl(std::size_t slot_i, ctrl_type ctrl) noexcept {
+			ctrls[slot_i] = ctrl;
+			if (slot_i < group_width) {
+				ctrls[capacity() + slot_i] = ctrl; // mirrored so a group read near the end wraps around
+			}
+		}
+
+		constexpr void rehash(std::size_t n) {
+			std::vector<value_type> old_slots = std::exchange(slots, std::vector<value_type>(n));
+			std::vector<ctrl_type> old_ctrls = std::exchange(ctrls, std::vector<ctrl_type>(n + group_width, empty_ctrl));
+
+			for (std::size_t slot_i = 0; slot_i < old_slots.size(); ++slot_i) {
+				if (old_ctrls[slot_i] == empty_ctrl) continue;
+
+				std::size_t hash = mix(key_of(old_slots[slot_i]));
+				std::size_t dst = insert_slot(hash);
+				slots[dst] = std::move(old_slots[slot_i]);
+				set_ctrl(dst, fingerprint(hash));
+			}
+		}
+
+		std::vector<value_type> slots;
+		std::vector<ctrl_type> ctrls; // capacity + group_width bytes, the tail mirrors the first group
+		std::size_t count = 0;
+	};
+}
+
+namespace ecs {
+	template<typename K, typename V, typename hash_T=std::hash<K>, typename eq_T=std::equal_to<K>>
+	class flat_map : public details::flat_table<std::pair<K, V>, K, hash_T, eq_T> {
+	public:
+		using mapped_type = V;
+
+		constexpr V& at(const K& key) {
+			auto it = this->find(key);
+			if (it == this->end()) throw std::out_of_range("flat_map key not found");
+			return it->second;
+		}
+
+		constexpr const V& at(const K& key) const {
+			auto it = this->find(key);
+			if (it == this->end()) throw std::out_of_range("flat_map key not found");
+			return it->second;
+		}
+	};
+
+	template<typename K, typename hash_T=std::hash<K>, typename eq_T=std::equal_to<K>>
+	class flat_set : public details::flat_table<K, K, hash_T, eq_T> { };
+}
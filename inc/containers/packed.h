@@ -3,6 +3,10 @@
 #include <memory>
 #include <vector>
 #include <algorithm>
+#include <ranges>
+#include <cstring>
+#include <cassert>
+#include <stdexcept>
 
 namespace ecs {
 	template<typename T, std::size_t N=4096, typename Alloc_T=std::allocator<T>>
@@ -106,10 +110,16 @@ namespace ecs {
 		template<std::input_iterator It>
 		constexpr iterator insert(const_iterator pos, It first, It last);
 		constexpr iterator insert(const_iterator pos, std::initializer_list<T> ilist);
+		template<std::ranges::input_range R>
+		constexpr iterator insert_range(const_iterator pos, R&& rg);
+		template<std::ranges::input_range R>
+		constexpr void append_range(R&& rg);
+		constexpr void adopt(std::span<const page_type> new_pages, size_t n);
 		constexpr iterator erase(const_iterator pos);
 		constexpr iterator erase(const_iterator first, const_iterator last);
 		constexpr void swap(packed& other);
 		constexpr void clear() noexcept;
+		constexpr void relocate(size_t dst, size_t src, size_t n) requires std::is_trivially_copyable_v<T>;
 
 	private:
 		allocator_type alloc;
@@ -250,8 +260,11 @@ constexpr ecs::packed<T, N, Alloc_T>::~packed()
 			std::destroy_at(&pages[page_i]);
 		}
 
-		std::destroy_n(pages[page_n].data(), elem_n);
-		std::destroy_at(&pages[page_n]);
+		if (elem_n != 0) // an extent filling its last page may have no page past it after shrink_to_fit
+		{
+			std::destroy_n(pages[page_n].data(), elem_n);
+			std::destroy_at(&pages[page_n]);
+		}
 
 		// deallocate pages
 		for (int page_i = 0; page_i < page_count(); ++page_i)
@@ -537,6 +550,8 @@ constexpr size_t ecs::packed<T, N, Alloc_T>::capacity() const
 template<typename T, std::size_t N, typename Alloc_T>
 constexpr void ecs::packed<T, N, Alloc_T>::resize(size_t n)
 {
+	if (n == extent) return; // the page past a full last page may not exist
+
 	size_t page_n = extent / page_size;
 	size_t elem_n = extent % page_size;
 	size_t new_page_n = n / page_size;
@@ -555,21 +570,21 @@ constexpr void ecs::packed<T, N, Alloc_T>::resize(size_t n)
 			std::uninitialized_default_construct_n(pages[page_n].data() + elem_n, page_size - elem_n);
 			for (size_t page_i = page_n + 1; page_i < new_page_n; ++page_i)
 				std::uninitialized_default_construct_n(pages[page_i].data(), page_size);
-			std::uninitialized_default_construct_n(pages[new_page_n].data(), new_elem_n);
+			if (new_elem_n != 0) std::uninitialized_default_construct_n(pages[new_page_n].data(), new_elem_n);
 		}
 	}
 	else
 	{
 		if (page_n == new_page_n)
 		{
-			std::destroy_n(pages[page_n].data() + elem_n, elem_n - new_elem_n);
+			std::destroy_n(pages[page_n].data() + new_elem_n, elem_n - new_elem_n);
 		}
 		else
 		{
 			std::destroy_n(pages[new_page_n].data() + new_elem_n, page_size - new_elem_n);
-			for (size_t page_i = page_n + 1; page_i < page_n; ++page_i)
+			for (size_t page_i = new_page_n + 1; page_i < page_n; ++page_i)
 				std::destroy_n(pages[page_i].data(), page_size);
-			std::destroy_n(pages[page_n].data(), elem_n);
+			if (elem_n != 0) std::destroy_n(pages[page_n].data(), elem_n);
 		}
 	}
 
@@ -579,6 +594,8 @@ constexpr void ecs::packed<T, N, Alloc_T>::resize(size_t n)
 template<typename T, std::size_t N, typename Alloc_T>
 constexpr void ecs::packed<T, N, Alloc_T>::resize(size_t n, const T& value)
 {
+	if (n == extent) return; // the page past a full last page may not exist
+
 	size_t page_n = extent / page_size;
 	size_t elem_n = extent % page_size;
 	size_t new_page_n = n / page_size;
@@ -597,21 +614,21 @@ constexpr void ecs::packed<T, N, Alloc_T>::resize(size_t n, const T& value)
 			std::uninitialized_fill_n(pages[page_n].data() + elem_n, page_size - elem_n, value);
 			for (size_t page_i = page_n + 1; page_i < new_page_n; ++page_i)
 				std::uninitialized_fill_n(pages[page_i].data(), page_size, value);
-			std::uninitialized_fill_n(pages[new_page_n].data(), new_elem_n, value);
+			if (new_elem_n != 0) std::uninitialized_fill_n(pages[new_page_n].data(), new_elem_n, value);
 		}
 	}
 	else
 	{
 		if (page_n == new_page_n)
 		{
-			std::destroy_n(pages[page_n].data() + elem_n, new_elem_n - elem_n);
+			std::destroy_n(pages[page_n].data() + new_elem_n, elem_n - new_elem_n);
 		}
 		else
 		{
 			std::destroy_n(pages[new_page_n].data() + new_elem_n, page_size - new_elem_n);
-			for (size_t page_i = page_n + 1; page_i < page_n; ++page_i)
+			for (size_t page_i = new_page_n + 1; page_i < page_n; ++page_i)
 				std::destroy_n(pages[page_i].data(), page_size);
-			std::destroy_n(pages[page_n].data(), elem_n);
+			if (elem_n != 0) std::destroy_n(pages[page_n].data(), elem_n);
 		}
 	}
 
@@ -637,11 +654,11 @@ constexpr void ecs::packed<T, N, Alloc_T>::reserve(size_t n)
 template<typename T, std::size_t N, typename Alloc_T>
 constexpr void ecs::packed<T, N, Alloc_T>::shrink_to_fit()
 {
-	size_t page_end = (extent / page_size);
-	// deallocate pages
-	for (int page_i = extent / page_size; page_i != page_end; --page_i)
+	size_t count = extent == 0 ? 0 : ((extent - 1) / page_size) + 1;
+	// deallocate pages beyond the last occupied page
+	while (page_count() > count)
 	{
-		get_allocator().deallocate(pages[page_i].data(), page_size);
+		get_allocator().deallocate(pages.back().data(), page_size);
 		pages.pop_back();
 	}
 
@@ -747,6 +764,85 @@ constexpr void ecs::packed<T, N, Alloc_T>::push_back(T&& value)
 	std::construct_at(&pages[index / page_size][index % page_size], value);
 }
 
+template<typename T, std::size_t N, typename Alloc_T>
+template<std::ranges::input_range R>
+constexpr ecs::packed<T, N, Alloc_T>::iterator
+ecs::packed<T, N, Alloc_T>::insert_range(const_iterator pos, R&& rg)
+{
+	size_t index = pos - cbegin();
+	if constexpr (std::is_trivially_copyable_v<T> && std::ranges::sized_range<R>)
+	{
+		size_t n = std::ranges::size(rg);
+		reserve(extent + n);
+		relocate(index + n, index, extent - index);
+
+		// copies into the gap one destination page at a time
+		auto it = std::ranges::begin(rg);
+		for (size_t dst = index, last = index + n; dst != last; )
+		{
+			size_t count = std::min(page_size - dst % page_size, last - dst);
+			it = std::ranges::uninitialized_copy_n(it, count, &(*this)[dst], &(*this)[dst] + count).in;
+			dst += count;
+		}
+		extent += n;
+	}
+	else
+	{
+		size_t count = extent;
+		append_range(std::forward<R>(rg));
+		std::rotate(begin() + index, begin() + count, end());
+	}
+	return begin() + index;
+}
+
+template<typename T, std::size_t N, typename Alloc_T>
+template<std::ranges::input_range R>
+constexpr void ecs::packed<T, N, Alloc_T>::append_range(R&& rg)
+{
+	if constexpr (std::ranges::sized_range<R>)
+	{
+		size_t n = std::ranges::size(rg);
+		reserve(extent + n);
+
+		// elements of an owning range passed as an rvalue are moved
+		constexpr bool movable = !std::is_lvalue_reference_v<R> && !std::ranges::view<std::remove_cvref_t<R>>;
+		
+		auto it = std::ranges::begin(rg);
+		while (n != 0)
+		{
+			size_t elem_i = extent % page_size;
+			size_t count = std::min(page_size - elem_i, n);
+			T* dst = pages[extent / page_size].data() + elem_i;
+
+			if constexpr (movable)
+				it = std::ranges::uninitialized_move_n(it, count, dst, dst + count).in;
+			else
+				it = std::ranges::uninitialized_copy_n(it, count, dst, dst + count).in;
+			
+			extent += count;
+			n -= count;
+		}
+	}
+	else
+	{
+		for (auto&& value : rg)
+			emplace_back(std::forward<decltype(value)>(value));
+	}
+}
+
+template<typename T, std::size_t N, typename Alloc_T>
+constexpr void ecs::packed<T, N, Alloc_T>::adopt(std::span<const page_type> new_pages, size_t n)
+{
+	// takes ownership of pages allocated by get_allocator() holding n constructed elements, only the last page may be partially filled.
+	// the pages are spliced in after the occupied pages without copying, reserved pages move behind them
+	// the preconditions are checked before ownership is taken, on throw the caller still owns the pages
+	if (extent % page_size != 0) throw std::invalid_argument("paged vector adopt requires a page aligned size");
+	if (n > new_pages.size() * page_size || n + page_size <= new_pages.size() * page_size) throw std::invalid_argument("paged vector adopt element count does not match the page count");
+
+	pages.insert(pages.begin() + extent / page_size, new_pages.begin(), new_pages.end());
+	extent += n;
+}
+
 template<typename T, std::size_t N, typename Alloc_T>
 constexpr void ecs::packed<T, N, Alloc_T>::pop_back()
 {
@@ -758,12 +854,21 @@ template<typename T, std::size_t N, typename Alloc_T> template<typename ... Arg_
 constexpr ecs::packed<T, N, Alloc_T>::iterator
 ecs::packed<T, N, Alloc_T>::emplace(const_iterator pos, Arg_Ts&&... args)
 {
-	reserve(extent + 1);
-	iterator it = begin() + (pos - cbegin());
-	std::move_backward(it, end(), end() + 1);
-	std::construct_at<T>(&(*it), std::forward<Arg_Ts>(args)...);
-	++extent;
-	return it;
+	size_t index = pos - cbegin();
+	if constexpr (std::is_trivially_copyable_v<T>)
+	{
+		T value(std::forward<Arg_Ts>(args)...); // args may refer to a shifted element
+		reserve(extent + 1);
+		relocate(index + 1, index, extent - index);
+		std::construct_at(&(*this)[index], value);
+		++extent;
+	}
+	else
+	{
+		emplace_back(std::forward<Arg_Ts>(args)...);
+		std::rotate(begin() + index, end() - 1, end());
+	}
+	return begin() + index;
 }
 
 template<typename T, std::size_t N, typename Alloc_T>
@@ -784,25 +889,30 @@ template<typename T, std::size_t N, typename Alloc_T>
 constexpr ecs::packed<T, N, Alloc_T>::iterator
 ecs::packed<T, N, Alloc_T>::insert(const_iterator pos, size_t n, const T& value)
 {
-	iterator it = begin() + (pos - cbegin());
-	reserve(extent + n);
-	std::move_backward(it, end(), end() + n);
-	std::uninitialized_fill_n(it, n, value);
-	extent += n;
-	return it;
+	size_t index = pos - cbegin();
+	if constexpr (std::is_trivially_copyable_v<T>)
+	{
+		T copy = value; // value may refer to a shifted element
+		reserve(extent + n);
+		relocate(index + n, index, extent - index);
+		std::uninitialized_fill_n(begin() + index, n, copy);
+		extent += n;
+	}
+	else
+	{
+		size_t count = extent;
+		for (size_t i = 0; i < n; ++i)
+			emplace_back(value);
+		std::rotate(begin() + index, begin() + count, end());
+	}
+	return begin() + index;
 }
 
 template<typename T, std::size_t N, typename Alloc_T> template<std::input_iterator It>
 constexpr ecs::packed<T, N, Alloc_T>::iterator
 ecs::packed<T, N, Alloc_T>::insert(const_iterator pos, It first, It last)
 {
-	size_t n = last - first;
-	iterator it = begin() + (pos - cbegin());
-	reserve(extent + n);
-	std::move_backward(pos, cend(), end() + n);
-	std::uninitialized_copy(first, last, it);
-	extent += n;
-	return it;
+	return insert_range(pos, std::ranges::subrange(first, last));
 }
 
 template<typename T, std::size_t N, typename Alloc_T>
@@ -816,29 +926,41 @@ template<typename T, std::size_t N, typename Alloc_T>
 constexpr ecs::packed<T, N, Alloc_T>::iterator
 ecs::packed<T, N, Alloc_T>::erase(const_iterator pos)
 {
-	iterator it1 = begin() + (pos - cbegin());
-	iterator it2 = it1 + 1;
-
-	if (it2 != end()) std::move(it2, end(), it1);
-	else std::destroy_at(&*it1);
+	size_t index = pos - cbegin();
+	if constexpr (std::is_trivially_copyable_v<T>)
+	{
+		relocate(index, index + 1, extent - index - 1);
+	}
+	else
+	{
+		std::move(begin() + index + 1, end(), begin() + index);
+		std::destroy_at(&back());
+	}
 
 	extent -= 1;
-	return it1;
+	return begin() + index;
 }
 
 template<typename T, std::size_t N, typename Alloc_T>
 constexpr ecs::packed<T, N, Alloc_T>::iterator
 ecs::packed<T, N, Alloc_T>::erase(const_iterator first, const_iterator last)
 {
-	size_t n = (last - first);
-	iterator it1 = begin() + (first - cbegin());
-	iterator it2 = it1 + (last - cbegin());
+	size_t index = first - cbegin();
+	size_t n = last - first;
+	if (n == 0) return begin() + index;
 
-	if (it2 != end()) std::move(it2, end(), it1);
-	else std::destroy(it1, it2);
+	if constexpr (std::is_trivially_copyable_v<T>)
+	{
+		relocate(index, index + n, extent - index - n);
+	}
+	else
+	{
+		iterator tail = std::move(begin() + index + n, end(), begin() + index);
+		std::destroy(tail, end());
+	}
 
 	extent -= n;
-	return it1;
+	return begin() + index;
 }
 
 template<typename T, std::size_t N, typename Alloc_T>
@@ -848,16 +970,52 @@ constexpr void ecs::packed<T, N, Alloc_T>::swap(packed& other)
 	std::swap(pages, other.pages);
 }
 
+template<typename T, std::size_t N, typename Alloc_T>
+constexpr void ecs::packed<T, N, Alloc_T>::relocate(size_t dst, size_t src, size_t n) requires std::is_trivially_copyable_v<T>
+{
+	// moves n elements with one memmove per chunk bounded by both the source and the destination page,
+	// chunks are visited in the direction that keeps overlapping ranges intact. dst may lie in reserved, unconstructed slots.
+	if (n == 0 || dst == src) return;
+
+	if (dst < src)
+	{
+		while (n != 0)
+		{
+			size_t count = std::min({ n, page_size - src % page_size, page_size - dst % page_size });
+			std::memmove(&(*this)[dst], &(*this)[src], count * sizeof(T));
+			dst += count;
+			src += count;
+			n -= count;
+		}
+	}
+	else
+	{
+		dst += n;
+		src += n;
+		while (n != 0)
+		{
+			size_t count = std::min({ n, (src - 1) % page_size + 1, (dst - 1) % page_size + 1 });
+			dst -= count;
+			src -= count;
+			n -= count;
+			std::memmove(&(*this)[dst], &(*this)[src], count * sizeof(T));
+		}
+	}
+}
+
 template<typename T, std::size_t N, typename Alloc_T>
 constexpr void ecs::packed<T, N, Alloc_T>::clear() noexcept
 {
 	if (extent == 0) return;
 
-	size_t page_n = extent / page_size;
-	size_t elem_n = extent % page_size;
-	for (int page_i = 0; page_i < page_n; ++page_i)
-		std::destroy_n(pages[page_i].data(), page_size);
-	std::destroy_n(pages[page_n].data(), elem_n);
+	// trivially destructible elements are dropped with their pages' extent, no per element pass
+	if constexpr (!std::is_trivially_destructible_v<T>) {
+		size_t page_n = extent / page_size;
+		size_t elem_n = extent % page_size;
+		for (size_t page_i = 0; page_i < page_n; ++page_i)
+			std::destroy_n(pages[page_i].data(), page_size);
+		if (elem_n != 0) std::destroy_n(pages[page_n].data(), elem_n);
+	}
 	
 	extent = 0;
 }
@@ -2,6 +2,11 @@
 #include <memory>
 #include <vector>
 #include <span>
+#include <array>
+#include <algorithm>
+#include <stdexcept>
+#include <bit>
+#include <utility>
 
 namespace ecs {
 	template<std::unsigned_integral T, std::size_t N=4096>
@@ -9,19 +14,23 @@ namespace ecs {
 
 	template<std::unsigned_integral T>
 	class sparse_iterator;
-	
+
 	template<std::unsigned_integral T, std::size_t N>
-	class sparse { 
+	class sparse {
 		static constexpr std::size_t page_size = N;
 		using page_type = std::span<T, page_size>;
 		static constexpr T tombstone = static_cast<T>(-1);
+
+		// absent pages refer to the shared tombstone page, lookups never branch on a missing page. the page is never written.
+		static constexpr std::array<T, page_size> make_tombstone_page() { std::array<T, page_size> page; page.fill(tombstone); return page; }
+		alignas(64) inline static std::array<T, page_size> tombstone_page = make_tombstone_page();
 	public:
 		using key_type = std::size_t;
 		using mapped_type = T;
 		using value_type = std::pair<const key_type, mapped_type>;
 		using size_type = std::size_t;
 		using difference_type = std::ptrdiff_t;
-		using allocator_type = std::allocator<T>; 
+		using allocator_type = std::allocator<T>;
 		using page_allocator_type = std::allocator_traits<allocator_type>::template rebind_alloc<page_type>;
 		using iterator = sparse_iterator<T>;
 		using const_iterator = sparse_iterator<const T>;
@@ -31,20 +40,22 @@ namespace ecs {
 		constexpr sparse() noexcept(noexcept(allocator_type()) && noexcept(page_allocator_type())) : sparse(allocator_type(), page_allocator_type()) { }
 		constexpr explicit sparse(const allocator_type& alloc) noexcept(noexcept(page_allocator_type())) : sparse(alloc, page_allocator_type()) { }
 		constexpr explicit sparse(const allocator_type& elem_alloc, const page_allocator_type& page_alloc) noexcept;
-		
+
 		constexpr sparse(const sparse& other);
-		constexpr sparse(sparse&& other);
-		
+		constexpr sparse(sparse&& other) noexcept;
+
 		constexpr ~sparse();
 
 		constexpr sparse& operator=(const sparse& other);
-		constexpr sparse& operator=(sparse&& other);
-		
-		
+		constexpr sparse& operator=(sparse&& other) noexcept;
+
+
 		constexpr allocator_type& get_allocator() noexcept;
-		constexpr page_allocator_type& get_page_allocator() noexcept;
+		constexpr page_allocator_type get_page_allocator() const noexcept;
 
 		[[nodiscard]] constexpr std::size_t size() const;
+		[[nodiscard]] constexpr bool empty() const;
+		[[nodiscard]] constexpr std::size_t page_count() const; // pages holding at least one key
 
 		constexpr T& at(key_type key);
 		constexpr const T& at(key_type key) const;
@@ -54,18 +65,26 @@ namespace ecs {
 		constexpr const_iterator cend() const noexcept;
 
 		constexpr void clear() noexcept;
+		constexpr void shrink_to_fit();
 
 		constexpr std::pair<iterator, bool> emplace(key_type key, mapped_type val);
 		constexpr std::size_t erase(key_type key);
 
 		[[nodiscard]] constexpr iterator find(key_type key);
 		[[nodiscard]] constexpr const_iterator find(key_type key) const;
-		
+
 		[[nodiscard]] constexpr bool contains(key_type key) const;
 	private:
+		constexpr bool allocated(const page_type& page) const noexcept { return page.data() != tombstone_page.data(); }
+		constexpr page_type acquire_page();
+		constexpr void release_page(page_type& page) noexcept;
+		constexpr void release_pages() noexcept;
+
 		allocator_type alloc;
 		data_type pages;
-		std::size_t count;
+		std::vector<std::size_t> occupancy; // live keys per page, an empty page is released
+		std::size_t count = 0;
+		T* spare = nullptr; // the last released page kept to absorb churn at a page boundary, filled with tombstones
 	};
 
 	template<std::unsigned_integral T>
@@ -73,70 +92,90 @@ namespace ecs {
 	public:
 		using key_type = std::size_t;
 		using mapped_type = T;
-		using value_type = std::pair<const key_type, mapped_type>;
+		using value_type = std::pair<const key_type, std::remove_const_t<mapped_type>>;
 		using difference_type = std::ptrdiff_t;
-		using pointer = std::pair<const key_type, mapped_type&>;
 		using reference = std::pair<const key_type, mapped_type&>;
-
-		using iterator_category = std::random_access_iterator_tag;
+		struct pointer {
+			reference ref;
+			constexpr reference* operator->() noexcept { return &ref; }
+		};
 
 	public:
-		constexpr sparse_iterator() : ptr(nullptr) { };
-		constexpr sparse_iterator(std::size_t key, pointer ptr) : ptr(ptr) { };
+		constexpr sparse_iterator() : key(-1), ptr(nullptr) { };
+		constexpr sparse_iterator(std::size_t key, mapped_type* ptr) : key(key), ptr(ptr) { };
 		constexpr operator sparse_iterator<const T>() const { return { key, ptr }; }
 		constexpr reference operator*() const { return { key, *ptr }; }
-		constexpr reference operator->() const { return { key, *ptr }; }
+		constexpr pointer operator->() const { return { { key, *ptr } }; }
 		constexpr friend bool operator==(const sparse_iterator& lhs, const sparse_iterator& rhs) { return lhs.ptr == rhs.ptr; }
 	private:
-		const key_type key;
-		pointer ptr;
+		key_type key;
+		mapped_type* ptr;
 	};
 }
 
 template<std::unsigned_integral T, std::size_t N>
-constexpr ecs::sparse<T, N>::sparse(const allocator_type& elem_alloc, const page_allocator_type& page_alloc) noexcept 
+constexpr ecs::sparse<T, N>::sparse(const allocator_type& elem_alloc, const page_allocator_type& page_alloc) noexcept
  : alloc(elem_alloc), pages(page_alloc) { }
-		
+
 
 template<std::unsigned_integral T, std::size_t N>
-constexpr ecs::sparse<T, N>::sparse(const sparse& other) 
- : alloc(other.alloc), pages(other.pages) { }
+constexpr ecs::sparse<T, N>::sparse(const sparse& other)
+ : alloc(other.alloc), pages(other.pages.size(), page_type(tombstone_page), other.pages.get_allocator()), occupancy(other.occupancy), count(other.count)
+{
+	for (std::size_t page_i = 0; page_i < pages.size(); ++page_i) {
+		if (other.allocated(other.pages[page_i])) {
+			pages[page_i] = page_type{ get_allocator().allocate(page_size), page_size };
+			std::ranges::copy(other.pages[page_i], pages[page_i].begin());
+		}
+	}
+}
 
 template<std::unsigned_integral T, std::size_t N>
-constexpr ecs::sparse<T, N>::sparse(sparse&& other)
-: alloc(std::move(other.alloc)), pages(std::move(other.pages)) { }
+constexpr ecs::sparse<T, N>::sparse(sparse&& other) noexcept
+ : alloc(std::move(other.alloc)), pages(std::move(other.pages)), occupancy(std::move(other.occupancy)), count(std::exchange(other.count, 0)), spare(std::exchange(other.spare, nullptr))
+{
+	other.pages.clear();
+	other.occupancy.clear();
+}
 
 template<std::unsigned_integral T, std::size_t N>
 constexpr ecs::sparse<T, N>::~sparse() {
-	clear();
+	release_pages();
 }
 
 template<std::unsigned_integral T, std::size_t N>
 constexpr ecs::sparse<T, N>& ecs::sparse<T, N>::operator=(const sparse& other) {
 	if (this == &other) return *this;
 
-	alloc = other.alloc;
-	pages = other.pages;
+	sparse copy(other);
+	return *this = std::move(copy);
 }
 
 
 template<std::unsigned_integral T, std::size_t N>
-constexpr ecs::sparse<T, N>& ecs::sparse<T, N>::operator=(sparse&& other) {
+constexpr ecs::sparse<T, N>& ecs::sparse<T, N>::operator=(sparse&& other) noexcept {
 	if (this == &other) return *this;
 
+	release_pages();
 	alloc = std::move(other.alloc);
 	pages = std::move(other.pages);
+	occupancy = std::move(other.occupancy);
+	count = std::exchange(other.count, 0);
+	spare = std::exchange(other.spare, nullptr);
+	other.pages.clear();
+	other.occupancy.clear();
+	return *this;
 }
-		
+
 template<std::unsigned_integral T, std::size_t N>
-constexpr ecs::sparse<T, N>::allocator_type& 
+constexpr ecs::sparse<T, N>::allocator_type&
 ecs::sparse<T, N>::get_allocator() noexcept {
 	return alloc;
 }
 
 template<std::unsigned_integral T, std::size_t N>
-constexpr ecs::sparse<T, N>::page_allocator_type& 
-ecs::sparse<T, N>::get_page_allocator() noexcept {
+constexpr ecs::sparse<T, N>::page_allocator_type
+ecs::sparse<T, N>::get_page_allocator() const noexcept {
 	return pages.get_allocator();
 }
 
@@ -145,48 +184,77 @@ template<std::unsigned_integral T, std::size_t N>
 	return count;
 }
 
+template<std::unsigned_integral T, std::size_t N>
+[[nodiscard]] constexpr bool ecs::sparse<T, N>::empty() const {
+	return count == 0;
+}
 
+template<std::unsigned_integral T, std::size_t N>
+[[nodiscard]] constexpr std::size_t ecs::sparse<T, N>::page_count() const {
+	return std::ranges::count_if(occupancy, [](std::size_t n) { return n != 0; });
+}
 
 template<std::unsigned_integral T, std::size_t N>
 constexpr T& ecs::sparse<T, N>::at(key_type key) {
-	std::size_t page_i = key / page_size;
-	std::size_t elem_i = key % page_size;
-	return pages.at(page_i).at(elem_i);
+	auto it = find(key);
+	if (it == end()) throw std::out_of_range("sparse key not found");
+	return (*it).second;
 }
 
 template<std::unsigned_integral T, std::size_t N>
 constexpr const T& ecs::sparse<T, N>::at(key_type key) const {
-	std::size_t page_i = key / page_size;
-	std::size_t elem_i = key % page_size;
-	return pages.at(page_i).at(elem_i);
+	auto it = find(key);
+	if (it == end()) throw std::out_of_range("sparse key not found");
+	return (*it).second;
 }
 
 template<std::unsigned_integral T, std::size_t N>
-constexpr ecs::sparse<T, N>::iterator 
+constexpr ecs::sparse<T, N>::iterator
 ecs::sparse<T, N>::end() noexcept {
 	return { tombstone, nullptr };
 }
 
 template<std::unsigned_integral T, std::size_t N>
-constexpr ecs::sparse<T, N>::const_iterator 
+constexpr ecs::sparse<T, N>::const_iterator
 ecs::sparse<T, N>::end() const noexcept {
 	return { tombstone, nullptr };
 }
 
 template<std::unsigned_integral T, std::size_t N>
-constexpr ecs::sparse<T, N>::const_iterator 
+constexpr ecs::sparse<T, N>::const_iterator
 ecs::sparse<T, N>::cend() const noexcept {
 	return { tombstone, nullptr };
 }
 
 template<std::unsigned_integral T, std::size_t N>
 void constexpr ecs::sparse<T, N>::clear() noexcept {
-	for (auto& page : pages) {
-		if (page.data() != nullptr) {
-			get_allocator().deallocate(page.data(), page_size);
+	if (count == 0) return;
+
+	// returns each occupied page in a single pass, the page table is kept
+	for (std::size_t page_i = 0; page_i < pages.size(); ++page_i) {
+		if (occupancy[page_i] != 0) {
+			std::ranges::fill(pages[page_i], tombstone);
+			release_page(pages[page_i]);
+			occupancy[page_i] = 0;
 		}
 	}
-	pages.clear();
+	count = 0;
+}
+
+template<std::unsigned_integral T, std::size_t N>
+constexpr void ecs::sparse<T, N>::shrink_to_fit() {
+	if (spare != nullptr) {
+		get_allocator().deallocate(spare, page_size);
+		spare = nullptr;
+	}
+
+	// trailing empty pages are dropped from the page table
+	while (!occupancy.empty() && occupancy.back() == 0) {
+		pages.pop_back();
+		occupancy.pop_back();
+	}
+	pages.shrink_to_fit();
+	occupancy.shrink_to_fit();
 }
 
 template<std::unsigned_integral T, std::size_t N>
@@ -194,20 +262,23 @@ constexpr std::pair<typename ecs::sparse<T, N>::iterator, bool> ecs::sparse<T, N
 	std::size_t page_i = key / page_size;
 	std::size_t elem_i = key % page_size;
 
-	if (pages.size() >= page_i) {
-		pages.resize(std::bit_ceil(page_i), page_type(static_cast<mapped_type*>(nullptr), page_size));
+	if (page_i >= pages.size()) {
+		std::size_t n = std::bit_ceil(page_i + 1);
+		pages.resize(n, page_type(tombstone_page));
+		occupancy.resize(n, 0);
 	}
 
-	auto& page = pages.at(page_i);
+	auto& page = pages[page_i];
 
-	if (page.data() == nullptr) {
-		page = page_type{ get_allocator().allocate(page_size), page_size };
+	if (!allocated(page)) {
+		page = acquire_page();
 	}
 
 	auto& elem = page[elem_i];
 
 	if (elem == tombstone) {
 		++count;
+		++occupancy[page_i];
 		elem = val;
 		return std::pair{ iterator{ key, &elem }, true };
 	} else {
@@ -221,48 +292,41 @@ constexpr std::size_t ecs::sparse<T, N>::erase(key_type key) {
 	std::size_t page_i = key / page_size;
 	std::size_t elem_i = key % page_size;
 
-	if (pages.size() >= page_i) {
+	if (page_i >= pages.size()) {
 		return 0;
 	}
 
-	auto& page = pages.at(page_i);
-
-	if (page.data() == nullptr) {
-		return 0;
-	}
-	
+	auto& page = pages[page_i];
 	auto& elem = page[elem_i];
 
 	if (elem == tombstone) {
 		return 0;
 	}
-	
+
 	--count;
 	elem = tombstone;
-	
+
+	if (--occupancy[page_i] == 0) {
+		release_page(page);
+	}
+
 	return 1;
 }
 
 template<std::unsigned_integral T, std::size_t N>
-constexpr ecs::sparse<T, N>::iterator 
+constexpr ecs::sparse<T, N>::iterator
 ecs::sparse<T, N>::find(key_type key) {
 	std::size_t page_i = key / page_size;
 	std::size_t elem_i = key % page_size;
 
-	if (pages.size() >= page_i) {
-		return { key, nullptr };
-	}
-
-	auto& page = pages.at(page_i);
-
-	if (page.data() == nullptr) {
-		return { key, nullptr };
+	if (page_i >= pages.size()) {
+		return end();
 	}
 
-	auto& elem = page.at(elem_i);
+	auto& elem = pages[page_i][elem_i];
 
 	if (elem == tombstone) {
-		return { key, nullptr };
+		return end();
 	}
 
 	return { key, &elem };
@@ -270,25 +334,19 @@ ecs::sparse<T, N>::find(key_type key) {
 
 
 template<std::unsigned_integral T, std::size_t N>
-constexpr ecs::sparse<T, N>::const_iterator 
+constexpr ecs::sparse<T, N>::const_iterator
 ecs::sparse<T, N>::find(key_type key) const {
 	std::size_t page_i = key / page_size;
 	std::size_t elem_i = key % page_size;
 
-	if (pages.size() >= page_i) {
-		return { key, nullptr };
+	if (page_i >= pages.size()) {
+		return end();
 	}
 
-	auto& page = pages.at(page_i);
-
-	if (page.data() == nullptr) {
-		return { key, nullptr };
-	}
+	const auto& elem = pages[page_i][elem_i];
 
-	auto& elem = page.at(elem_i);
-	
 	if (elem == tombstone) {
-		return { key, nullptr };
+		return end();
 	}
 
 	return { key, &elem };
@@ -298,6 +356,44 @@ template<std::unsigned_integral T, std::size_t N>
 [[nodiscard]] constexpr bool ecs::sparse<T, N>::contains(key_type key) const {
 	std::size_t page_i = key / page_size;
 	std::size_t elem_i = key % page_size;
-	
-	return (pages.size() < page_i) && (pages[page_i][elem_i] != tombstone);
+
+	return (page_i < pages.size()) && (pages[page_i][elem_i] != tombstone);
+}
+
+template<std::unsigned_integral T, std::size_t N>
+constexpr ecs::sparse<T, N>::page_type ecs::sparse<T, N>::acquire_page() {
+	if (spare != nullptr) {
+		return page_type{ std::exchange(spare, nullptr), page_size };
+	}
+
+	page_type page{ get_allocator().allocate(page_size), page_size };
+	std::ranges::fill(page, tombstone);
+	return page;
+}
+
+template<std::unsigned_integral T, std::size_t N>
+constexpr void ecs::sparse<T, N>::release_page(page_type& page) noexcept {
+	// the page holds only tombstones, it is kept as the spare or returned to the allocator
+	if (spare == nullptr) {
+		spare = page.data();
+	} else {
+		get_allocator().deallocate(page.data(), page_size);
+	}
+	page = page_type(tombstone_page);
+}
+
+template<std::unsigned_integral T, std::size_t N>
+constexpr void ecs::sparse<T, N>::release_pages() noexcept {
+	for (auto& page : pages) {
+		if (allocated(page)) {
+			get_allocator().deallocate(page.data(), page_size);
+		}
+	}
+	if (spare != nullptr) {
+		get_allocator().deallocate(spare, page_size);
+		spare = nullptr;
+	}
+	pages.clear();
+	occupancy.clear();
+	count = 0;
 }
@@ -0,0 +1,229 @@
+#pragma once
+#include "containers/sparse.h"
+#include <memory>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <stdexcept>
+#include <bit>
+#include <utility>
+#include <cassert>
+/*
+versioned sparse set. a paged sparse lookup keyed by the index bits of a
+handle that stores the full handle beside the mapped value. find, contains
+and erase compare the stored handle, a stale handle whose index was reused
+by a later version is rejected with the same load that reads the value.
+absent pages refer to a shared tombstone page, lookups never branch on a
+missing page.
+*/
+
+namespace ecs {
+	template<typename H, std::unsigned_integral T, std::size_t N=4096>
+	class versioned_sparse {
+		static constexpr std::size_t page_size = N;
+		static constexpr T tombstone = static_cast<T>(-1);
+
+		struct slot {
+			H key;
+			T val = tombstone;
+		};
+
+		alignas(64) inline static std::array<slot, page_size> tombstone_page{ }; // never written
+	public:
+		using key_type = H;
+		using mapped_type = T;
+		using size_type = std::size_t;
+		using allocator_type = std::allocator<slot>;
+		using iterator = sparse_iterator<T>;
+		using const_iterator = sparse_iterator<const T>;
+
+	public:
+		constexpr versioned_sparse() = default;
+		constexpr versioned_sparse(const versioned_sparse& other) : pages(other.pages.size(), tombstone_page.data()), occupancy(other.occupancy), count(other.count) {
+			for (std::size_t page_i = 0; page_i < pages.size(); ++page_i) {
+				if (other.allocated(other.pages[page_i])) {
+					pages[page_i] = alloc.allocate(page_size);
+					std::uninitialized_copy_n(other.pages[page_i], page_size, pages[page_i]);
+				}
+			}
+		}
+		constexpr versioned_sparse(versioned_sparse&& other) noexcept
+		 : pages(std::exchange(other.pages, { })), occupancy(std::exchange(other.occupancy, { })), count(std::exchange(other.count, 0)), spare(std::exchange(other.spare, nullptr)) { }
+
+		constexpr ~versioned_sparse() { release_pages(); }
+
+		constexpr versioned_sparse& operator=(const versioned_sparse& other) {
+			if (this == &other) return *this;
+			versioned_sparse copy(other);
+			return *this = std::move(copy);
+		}
+		constexpr versioned_sparse& operator=(versioned_sparse&& other) noexcept {
+			if (this == &other) return *this;
+			release_pages();
+			pages = std::exchange(other.pages, { });
+			occupancy = std::exchange(other.occupancy, { });
+			count = std::exchange(other.count, 0);
+			spare = std::exchange(other.spare, nullptr);
+			return *this;
+		}
+
+		[[nodiscard]] constexpr std::size_t size() const { return count; }
+		[[nodiscard]] constexpr bool empty() const { return count == 0; }
+
+		constexpr T& at(const key_type& key) {
+			auto it = find(key);
+			if (it == end()) throw std::out_of_range("versioned sparse key not found");
+			return (*it).second;
+		}
+		constexpr const T& at(const key_type& key) const {
+			auto it = find(key);
+			if (it == end()) throw std::out_of_range("versioned sparse key not found");
+			return (*it).second;
+		}
+
+		constexpr iterator end() noexcept { return { tombstone, nullptr }; }
+		constexpr const_iterator end() const noexcept { return { tombstone, nullptr }; }
+		constexpr const_iterator cend() const noexcept { return { tombstone, nullptr }; }
+
+		/* inserts or replaces the value of the key. an index held by another version is never overwritten, the stale key must be erased first, see occupant. */
+		constexpr std::pair<iterator, bool> emplace(const key_type& key, mapped_type val) {
+			std::size_t page_i = std::size_t(key) / page_size;
+			std::size_t elem_i = std::size_t(key) % page_size;
+
+			if (page_i >= pages.size()) {
+				std::size_t n = std::bit_ceil(page_i + 1);
+				pages.resize(n, tombstone_page.data());
+				occupancy.resize(n, 0);
+			}
+
+			if (!allocated(pages[page_i])) {
+				pages[page_i] = acquire_page();
+			}
+
+			auto& elem = pages[page_i][elem_i];
+			if (elem.val == tombstone) {
+				++count;
+				++occupancy[page_i];
+				elem = { key, val };
+				return { iterator{ std::size_t(key), &elem.val }, true };
+			}
+
+			assert(elem.key == key && "index held by another version");
+			if (!(elem.key == key)) return { end(), false };
+
+			elem.val = val;
+			return { iterator{ std::size_t(key), &elem.val }, false };
+		}
+
+		/* erases the value of the key, returns 0 if the index holds another version. */
+		constexpr std::size_t erase(const key_type& key) {
+			slot* elem = lookup(key);
+			if (elem == nullptr) return 0;
+
+			std::size_t page_i = std::size_t(key) / page_size;
+			--count;
+			*elem = slot{ };
+
+			if (--occupancy[page_i] == 0) {
+				release_page(pages[page_i]);
+			}
+			return 1;
+		}
+
+		[[nodiscard]] constexpr iterator find(const key_type& key) {
+			slot* elem = lookup(key);
+			return elem ? iterator{ std::size_t(key), &elem->val } : end();
+		}
+		[[nodiscard]] constexpr const_iterator find(const key_type& key) const {
+			const slot* elem = lookup(key);
+			return elem ? const_iterator{ std::size_t(key), &elem->val } : end();
+		}
+
+		[[nodiscard]] constexpr bool contains(const key_type& key) const { return lookup(key) != nullptr; }
+
+		/* returns the key of any version stored at the index, or nullptr if the index is vacant. */
+		[[nodiscard]] constexpr const key_type* occupant(std::size_t index) const {
+			std::size_t page_i = index / page_size;
+			if (page_i >= pages.size()) return nullptr;
+
+			const slot& elem = pages[page_i][index % page_size];
+			return elem.val != tombstone ? &elem.key : nullptr;
+		}
+
+		constexpr void clear() noexcept {
+			if (count == 0) return;
+
+			for (std::size_t page_i = 0; page_i < pages.size(); ++page_i) {
+				if (occupancy[page_i] != 0) {
+					std::fill_n(pages[page_i], page_size, slot{ });
+					release_page(pages[page_i]);
+					occupancy[page_i] = 0;
+				}
+			}
+			count = 0;
+		}
+
+		constexpr void shrink_to_fit() {
+			if (spare != nullptr) {
+				alloc.deallocate(std::exchange(spare, nullptr), page_size);
+			}
+
+			while (!occupancy.empty() && occupancy.back() == 0) {
+				pages.pop_back();
+				occupancy.pop_back();
+			}
+			pages.shrink_to_fit();
+			occupancy.shrink_to_fit();
+		}
+
+	private:
+		constexpr bool allocated(const slot* page) const noexcept { return page != tombstone_page.data(); }
+
+		/* returns the slot holding the key, or nullptr if the index is vacant or holds another version. */
+		constexpr slot* lookup(const key_type& key) const {
+			std::size_t page_i = std::size_t(key) / page_size;
+			if (page_i >= pages.size()) return nullptr;
+
+			slot& elem = pages[page_i][std::size_t(key) % page_size];
+			return (elem.val != tombstone && elem.key == key) ? &elem : nullptr;
+		}
+
+		constexpr slot* acquire_page() {
+			if (spare != nullptr) {
+				return std::exchange(spare, nullptr);
+			}
+
+			slot* page = alloc.allocate(page_size);
+			std::uninitialized_fill_n(page, page_size, slot{ });
+			return page;
+		}
+
+		constexpr void release_page(slot*& page) noexcept {
+			// the page holds only tombstones, it is kept as the spare or returned to the allocator
+			if (spare == nullptr) {
+				spare = page;
+			} else {
+				alloc.deallocate(page, page_size);
+			}
+			page = tombstone_page.data();
+		}
+
+		constexpr void release_pages() noexcept {
+			for (slot* page : pages) {
+				if (allocated(page)) alloc.deallocate(page, page_size);
+			}
+			if (spare != nullptr) {
+				alloc.deallocate(std::exchange(spare, nullptr), page_size);
+			}
+			pages.clear();
+			occupancy.clear();
+			count = 0;
+		}
+
+		[[no_unique_address]] allocator_type alloc;
+		std::vector<slot*> pages;
+		std::vector<std::size_t> occupancy; // live keys per page, an empty page is released
+		std::size_t count = 0;
+		slot* spare = nullptr; // the last released page kept to absorb churn at a page boundary, filled with tombstones
+	};
+}
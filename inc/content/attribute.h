@@ -2,8 +2,15 @@
 #include "core/traits.h"
 #include "containers/packed.h"
 #include "containers/sparse.h"
+#include "containers/versioned_sparse.h"
+#include "containers/flat_map.h"
+#include "containers/columns.h"
+#include "containers/bitmap.h"
 #include <unordered_map>
-#include <set>
+#include <optional>
+#include <vector>
+#include <utility>
+#include <cassert>
 
 namespace ecs {
 	template<traits::component_class T>
@@ -20,7 +27,20 @@ namespace ecs {
 	template<traits::component_class T>
 	struct indexer {
 		using ecs_category = tag::attribute;
-		using value_type = std::conditional_t<std::is_void_v<traits::component::get_manager_t<T>>, std::set<traits::component::get_handle_t<T>>, std::conditional_t<std::is_assignable_v<std::size_t, traits::component::get_handle_t<T>>, ecs::sparse<std::size_t, traits::component::get_page_size_v<T>>, std::unordered_map<traits::component::get_handle_t<T>, std::size_t>>>;
+		using index_type = traits::component::get_index_t<T>;
+		static_assert(std::unsigned_integral<index_type>, "index_type must be an unsigned integral.");
+
+		using handle_type = traits::component::get_handle_t<T>;
+		static constexpr std::size_t page_size = traits::component::get_page_size_v<T>;
+
+		static constexpr bool version_checked = traits::component::get_version_checked_v<T>;
+		static_assert(!version_checked || std::is_convertible_v<handle_type, std::size_t>, "version checked indexer requires a handle convertible to its entity index.");
+
+		// handles converting to their index key the sparse directly, version checked components store the handle beside the index. other handles and pools without a manager hash the handle
+		using value_type = std::conditional_t<std::is_void_v<traits::component::get_manager_t<T>>, ecs::flat_set<handle_type>, 
+			std::conditional_t<version_checked, ecs::versioned_sparse<handle_type, index_type, page_size>, 
+			std::conditional_t<std::is_convertible_v<handle_type, std::size_t>, ecs::sparse<index_type, page_size>, 
+			ecs::flat_map<handle_type, index_type>>>>;
 	};
 
 	template<traits::component_class T>
@@ -29,6 +49,158 @@ namespace ecs {
 		using value_type = ecs::packed<traits::component::get_value_t<T>>;
 	};
 
+	template<traits::component_class T>
+	struct column_storage {
+		using ecs_category = tag::attribute;
+		using value_type = ecs::columns<traits::component::get_value_t<T>>;
+	};
+
+	template<traits::component_class ... Ts>
+	struct group {
+		using ecs_category = tag::attribute;
+		using value_type = std::size_t; // number of entities packed at the front of each pool in the group
+	};
+
+	template<traits::component_class T>
+	struct free_list {
+		using ecs_category = tag::attribute;
+		using value_type = std::vector<std::size_t>; // vacant indices of a pointer stable pool
+	};
+
+	template<traits::component_class T>
+	struct graveyard {
+		using ecs_category = tag::attribute;
+		using value_type = std::vector<std::pair<std::size_t, traits::component::get_handle_t<T>>>; // index and handle of each tombstone awaiting compaction
+	};
+
+	template<traits::component_class T>
+	struct alignment {
+		using ecs_category = tag::attribute;
+		using value_type = std::size_t; // number of entities at the front of the pool ordered by the last sort_as, views probe the manager before the indexer within it
+	};
+
+	struct change_ticks {
+		std::size_t added;
+		std::size_t changed;
+	};
+
+	template<traits::component_class T>
+	struct tracker {
+		using ecs_category = tag::attribute;
+		struct value_type {
+			std::size_t tick = 1; // elements stamped with the current tick were added or changed within this window
+			ecs::packed<change_ticks> column; // parallel to the manager
+		};
+
+		static void shrink(auto& reg, value_type& val) {
+			val.column.shrink_to_fit();
+		}
+	};
+
+	template<traits::component_class T>
+	struct presence {
+		using ecs_category = tag::attribute;
+		using value_type = ecs::bitmap; // one bit per entity index, set while the entity holds the component
+
+		static void shrink(auto& reg, value_type& val) {
+			val.shrink_to_fit();
+		}
+	};
+
+	template<traits::component_class T>
+	struct command_buffer {
+		using ecs_category = tag::attribute;
+		using handle_type = traits::component::get_handle_t<T>;
+		using emplace_type = std::conditional_t<std::is_void_v<traits::component::get_storage_t<T>>, handle_type, std::pair<handle_type, traits::component::get_value_t<T>>>;
+		
+		struct value_type {
+			std::vector<emplace_type> emplaced; // constructed on record, moved into the pool on sync
+			std::vector<std::pair<handle_type, std::size_t>> erased; // each with the number of emplaces recorded before it, an erase cancels the emplaces of its handle recorded earlier
+		};
+
+		static void shrink(auto& reg, value_type& val) {
+			val.emplaced.shrink_to_fit();
+			val.erased.shrink_to_fit();
+		}
+	};
+
+	template<traits::component_class T>
+	struct library {
+		using ecs_category = tag::attribute;
+		using handle_type = traits::component::get_handle_t<T>;
+		using key_type = traits::component::get_key_t<T>;
+
+		/* returns the handle loaded with the key and true if the key was not yet loaded, the handle gains a reference. a reused slot hands out the next version of its handle, see factory. */
+		std::pair<handle_type, bool> acquire(const key_type& key) {
+			if (auto it = index.find(key); it != index.end()) {
+				++entries[it->second].count;
+				return { it->second, false };
+			}
+
+			handle_type hnd;
+			if (vacant.empty()) {
+				hnd = handle_type(entries.size());
+				entries.push_back({ key, 1, hnd });
+			} else {
+				std::size_t ind = vacant.back();
+				vacant.pop_back();
+				hnd = ++entries[ind].hnd; // a stale handle of the released asset no longer matches
+				entries[ind].key = key;
+				entries[ind].count = 1;
+			}
+
+			index.emplace(key, hnd);
+			return { hnd, true };
+		}
+
+		/* adds a reference to the handle. */
+		constexpr void retain(handle_type hnd) {
+			assert(contains(hnd));
+			if (!contains(hnd)) return;
+			++entries[hnd].count;
+		}
+
+		/* removes a reference from the handle, returns true when the last reference was released and the key unloaded. a stale or unloaded handle is ignored. */
+		bool release(handle_type hnd) {
+			if (!contains(hnd)) return false;
+
+			auto& entry = entries[hnd];
+			if (--entry.count != 0) return false;
+
+			index.erase(entry.key);
+			vacant.push_back(hnd);
+			return true;
+		}
+
+		/* returns the handle loaded with the key, or nullopt if not loaded. */
+		std::optional<handle_type> find(const key_type& key) const {
+			if (auto it = index.find(key); it != index.end()) {
+				return it->second;
+			}
+			return std::nullopt;
+		}
+
+		/* returns true if the handle is loaded, a stale version of a released handle is rejected. */
+		constexpr bool contains(handle_type hnd) const {
+			return std::size_t(hnd) < entries.size() && entries[hnd].count != 0 && entries[hnd].hnd == hnd;
+		}
+
+		constexpr std::size_t use_count(handle_type hnd) const {
+			return contains(hnd) ? entries[hnd].count : 0;
+		}
+
+	private:
+		struct entry {
+			key_type key;
+			std::size_t count;
+			handle_type hnd; // the current version of the slot
+		};
+
+		std::unordered_map<key_type, handle_type> index;
+		std::vector<entry> entries; // indexed by the handle index
+		std::vector<std::size_t> vacant;
+	};
+
 	template<traits::entity_class T>
 	struct factory {
 		using ecs_category = tag::attribute;
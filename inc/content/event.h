@@ -1,5 +1,6 @@
 #pragma once
 #include "core/traits.h"
+#include <span>
 
 namespace ecs::event {
 	template<traits::entity_class T, typename reg_T>
@@ -37,7 +38,7 @@ namespace ecs::event {
 			if constexpr (std::is_void_v<value_type> || std::is_empty_v<value_type>) 
 				return std::type_identity<void(reg_T&, handle_type)>{};
 			else 
-				return std::type_identity<void(reg_T&, handle_type, value_type&)>{}; 
+				return std::type_identity<void(reg_T&, handle_type, traits::component::get_reference_t<T>)>{}; 
 		}())::type;
 	};
 	
@@ -56,10 +57,23 @@ namespace ecs::event {
 			if constexpr (std::is_void_v<value_type> || std::is_empty_v<value_type>) 
 				return std::type_identity<void(reg_T&, handle_type)>{};
 			else 
-				return std::type_identity<void(reg_T&, handle_type, value_type&)>{}; 
+				return std::type_identity<void(reg_T&, handle_type, traits::component::get_reference_t<T>)>{}; 
 		}())::type;
 	};
 
+	template<traits::component_class T, typename reg_T>
+	struct update {
+	private:
+		using handle_type = traits::component::get_handle_t<T>;
+	public:
+		using ecs_category = tag::event;
+
+		template<typename reg_U> 
+		using rebind_registry = update<T, reg_U>;
+
+		using callback_type = void(reg_T&, std::span<const handle_type>); // the handles of the patched components
+	};
+
 	template<traits::attribute_class T, typename reg_T>
 	struct acquire {
 		using ecs_category = tag::event;
@@ -1,6 +1,10 @@
+#pragma once
+#include "core/fwd.h"
 #include <algorithm>
 #include <ranges>
 #include <vector>
+#include <tuple>
+#include <span>
 
 namespace ecs::policy {
 	struct optimal {
@@ -10,27 +14,28 @@ namespace ecs::policy {
 				return std::ranges::subrange(range.end(), range.end());
 			} else {
 				range.emplace_back(std::move(*it));
-				std::construct_at(&*it, std::forward<decltype(args)>(args)...);
+				*it = typename std::remove_cvref_t<decltype(range)>::value_type(std::forward<decltype(args)>(args)...);
 				return std::ranges::subrange(range.end() - 1, range.end());
 			}
 
 		}
 
-		constexpr auto emplace_n(auto& range, auto it, std::size_t n, auto&& ... args) {
+		constexpr auto emplace_n(auto& range, auto it, std::size_t n, auto&& ... args) { // args construct n values and are never forwarded
 			auto end = range.end();
 			auto dst = it + n;
 			
 			for (; dst > end; --dst) {
-				range.emplace_back(std::forward<decltype(args)>(args)...);
+				range.emplace_back(args...);
 			}
 			
 			auto mv = range.end();
-			std::move(it, dst, std::back_inserter(range));
+			for (std::size_t i = it - range.begin(), stop = dst - range.begin(); i < stop; ++i) { // columns have no push_back, each value is moved through emplace_back
+				range.emplace_back(std::move(range[i]));
+			}
 			auto mv_end = range.end();
 
-			--dst;
-			for (; dst >= it; --dst) {
-				std::construct_at(&(*dst), std::forward<decltype(args)>(args)...);
+			for (auto pos = it; pos != dst; ++pos) { // a reverse walk would step before begin when it is the front
+				*pos = typename std::remove_cvref_t<decltype(range)>::value_type(args...);
 			}
 			
 			return std::ranges::subrange(mv, mv_end);
@@ -50,13 +55,14 @@ namespace ecs::policy {
 			}
 
 			auto mv = range.end();
-			std::move(it, dst, std::back_inserter(range));
+			for (std::size_t i = it - range.begin(), stop = dst - range.begin(); i < stop; ++i) { // columns have no push_back, each value is moved through emplace_back
+				range.emplace_back(std::move(range[i]));
+			}
 			auto mv_end = range.end();
 
-			--dst;
-			--src;
-			for (; dst >= it; --dst, --src) { 
-				*dst = std::move(*src); 
+			src -= std::distance(it, dst);
+			for (auto pos = it; pos != dst; ++pos, ++src) {
+				*pos = std::move(*src);
 			}
 
 			return std::ranges::subrange(mv, mv_end);
@@ -76,12 +82,34 @@ namespace ecs::policy {
 			auto end = it + n;
 			std::size_t count = std::distance(it, end);
 			if (end != range.end()) {
-				std::move(std::max(range.end() - count, end), range.end(), it);
+				auto src = std::max(range.end() - count, end);
+				if constexpr (requires { range.relocate(0, 0, 0); }) { // trivially copyable, page-wise memmove
+					range.relocate(it - range.begin(), src - range.begin(), range.end() - src);
+				} else {
+					std::move(src, range.end(), it);
+				}
 			} 
 			range.resize(range.size() - count);
 
 			return std::ranges::subrange(it, std::min(end, range.end()));
 		}
+
+		/** erases the sorted unique indices, moving elements from the back into the holes. returns the moved to indices. */
+		constexpr auto erase_sorted(auto& range, std::span<const std::size_t> indices) {
+			std::size_t n = range.size() - indices.size();
+			auto holes_end = std::lower_bound(indices.begin(), indices.end(), n);
+			auto back = indices.end(); // erased indices beyond the new end
+			std::size_t src = range.size();
+
+			for (auto hole = indices.begin(); hole != holes_end; ++hole) {
+				--src;
+				while (back != holes_end && *(back - 1) == src) { --back; --src; }
+				range[*hole] = std::move(range[src]);
+			}
+			range.resize(n);
+
+			return std::ranges::subrange(indices.begin(), holes_end);
+		}
 	};
 
 	struct strict {
@@ -91,25 +119,42 @@ namespace ecs::policy {
 			return std::ranges::subrange(it + 1, range.end());
 		}
 
-		constexpr auto emplace_n(auto& range, auto it, std::size_t n, auto&& ... args) {
+		constexpr auto emplace_n(auto& range, auto it, std::size_t n, auto&& ... args) { // args construct n values and are never forwarded
+			if (n == 0) return std::ranges::subrange(it, range.end());
+
+			if constexpr (requires { range.relocate(0, 0, 0); }) { // trivially copyable, shifts the tail with a page-wise memmove
+				std::size_t idx = it - range.begin();
+				std::size_t sz = range.size();
+				range.resize(sz + n);
+				range.relocate(idx + n, idx, sz - idx);
+				for (auto dst = it; dst != it + n; ++dst) {
+					*dst = typename std::remove_cvref_t<decltype(range)>::value_type(args...);
+				}
+				return std::ranges::subrange(it + n, range.end());
+			}
+
 			auto dst = it + n;
 			auto end = range.end();
+			auto last = std::min(dst, end); // [it, last) is assigned, [last, dst) is emplaced
 			
 			if (dst > end) {
-				std::size_t cnt = n - std::distance(end, dst);
+				std::size_t cnt = std::distance(it, end);
 				
-				do { range.emplace_back(std::forward<decltype(args)>(args)...); } while (--dst > end);
+				for (auto pos = end; pos != dst; ++pos) { range.emplace_back(args...); }
 				
-				std::move(it, it + cnt, std::back_inserter(range));
+				for (std::size_t i = it - range.begin(), stop = i + cnt; i < stop; ++i) {
+					range.emplace_back(std::move(range[i]));
+				}
 			} else {
-				std::move(dst, end, std::back_inserter(range));
+				for (std::size_t i = range.size() - n, stop = range.size(); i < stop; ++i) {
+					range.emplace_back(std::move(range[i]));
+				}
 			
-				std::move_backward(it, dst, end);
+				std::move_backward(it, end - n, end);
 			}
 
-			--dst;
-			for (; dst >= it; --dst) {
-				std::construct_at(&(*dst), std::forward<decltype(args)>(args)...);
+			for (auto pos = it; pos != last; ++pos) {
+				*pos = typename std::remove_cvref_t<decltype(range)>::value_type(args...);
 			}
 
 			return std::ranges::subrange(it + n, range.end());
@@ -130,5 +175,115 @@ namespace ecs::policy {
 			range.erase(it, it + n);
 			return std::ranges::subrange(it, range.end());
 		}
+
+		/** erases the sorted unique indices in a single compacting pass. returns the moved to indices. */
+		constexpr auto erase_sorted(auto& range, std::span<const std::size_t> indices) {
+			if (indices.empty()) return std::views::iota(range.size(), range.size());
+			
+			if constexpr (requires { range.relocate(0, 0, 0); }) { // trivially copyable, one page-wise memmove per gap
+				std::size_t dst = indices.front();
+				for (std::size_t i = 0; i < indices.size(); ++i) {
+					std::size_t first = indices[i] + 1;
+					std::size_t last = (i + 1 < indices.size()) ? indices[i + 1] : range.size();
+					range.relocate(dst, first, last - first);
+					dst += last - first;
+				}
+			} else {
+				auto dst = range.begin() + indices.front();
+				for (std::size_t i = 0; i < indices.size(); ++i) {
+					auto first = range.begin() + (indices[i] + 1);
+					auto last = (i + 1 < indices.size()) ? range.begin() + indices[i + 1] : range.end();
+					dst = std::move(first, last, dst);
+				}
+			}
+			
+			std::size_t n = range.size() - indices.size();
+			range.resize(n);
+			
+			return std::views::iota(indices.front(), n);
+		}
+	};
+
+	template<typename cmp_T>
+	struct sorted : strict {
+		using compare_type = cmp_T;
+
+		/** returns the position the value at it must be moved to, searching the sorted range before it. */
+		constexpr auto find_position(auto& range, auto it) -> decltype(it) {
+			return std::upper_bound(range.begin(), it, *it, cmp_T{});
+		}
+
+		/** moves the back of the range to it, shifting the elements in between. */
+		constexpr auto rotate_back(auto& range, auto it) {
+			if constexpr (requires { range.relocate(0, 0, 0); } && std::is_lvalue_reference_v<decltype(range.back())>) { // trivially copyable, shifts with a page-wise memmove
+				auto value = range.back();
+				std::size_t idx = it - range.begin();
+				range.relocate(idx + 1, idx, range.size() - 1 - idx);
+				*it = value;
+			} else { // swaps the back down one position at a time, column references are proxies and cannot be held as a temporary by std::rotate
+				for (auto pos = range.end() - 1; pos != it; --pos) {
+					std::ranges::iter_swap(pos - 1, pos);
+				}
+			}
+			return std::ranges::subrange(it + 1, range.end());
+		}
 	};
-}
\ No newline at end of file
+
+	/** erase leaves a tombstone, the pool compacts the tombstones in a single strict pass on compact. */
+	struct lazy : strict { };
+
+	template<typename ... Ts>
+	struct grouped : optimal {
+		using group_type = ecs::group<Ts...>;
+
+		template<typename T> static constexpr bool contains = (std::is_same_v<std::remove_const_t<T>, Ts> || ...);
+
+		/** swaps the entity to the back of the group if it owns every component in the group. */
+		constexpr void enter(auto& reg, auto hnd) {
+			if (!(reg.template has_component<Ts>(hnd) && ...)) return;
+
+			auto& count = reg.template get_attribute<group_type>();
+
+			if (reg.template pool<std::tuple_element_t<0, std::tuple<Ts...>>>().index_of(hnd) < count) return;
+
+			([&]<typename T>() {
+				auto pool = reg.template pool<T>();
+				pool.swap_at(pool.index_of(hnd), count);
+			}.template operator()<Ts>(), ...);
+
+			++count;
+		}
+
+		/** swaps the entity out of the group, must be called while it still owns every component in the group. */
+		constexpr void leave(auto& reg, auto hnd) {
+			if (!(reg.template has_component<Ts>(hnd) && ...)) return;
+
+			auto& count = reg.template get_attribute<group_type>();
+
+			if (reg.template pool<std::tuple_element_t<0, std::tuple<Ts...>>>().index_of(hnd) >= count) return;
+
+			--count;
+
+			([&]<typename T>() {
+				auto pool = reg.template pool<T>();
+				pool.swap_at(pool.index_of(hnd), count);
+			}.template operator()<Ts>(), ...);
+		}
+
+		constexpr void clear(auto& reg) {
+			reg.template get_attribute<group_type>() = 0;
+		}
+	};
+}
+
+namespace ecs::traits {
+	/* true if the component T shares its order with the pools of the sequence policy. */
+	template<typename policy_T, typename T> struct is_grouped : std::false_type { };
+	template<typename ... Ts, typename T> struct is_grouped<policy::grouped<Ts...>, T> : std::bool_constant<policy::grouped<Ts...>::template contains<T>> { };
+	template<typename policy_T, typename T> static constexpr bool is_grouped_v = is_grouped<policy_T, T>::value;
+
+	/* true if every component in the group declares the grouped policy, policy_of yields the sequence policy of a component. */
+	template<typename policy_T, template<typename> typename policy_of> struct is_group_shared : std::true_type { };
+	template<typename ... Ts, template<typename> typename policy_of> struct is_group_shared<policy::grouped<Ts...>, policy_of> : std::bool_constant<(std::is_same_v<policy_of<Ts>, policy::grouped<Ts...>> && ...)> { };
+	template<typename policy_T, template<typename> typename policy_of> static constexpr bool is_group_shared_v = is_group_shared<policy_T, policy_of>::value;
+}
@@ -11,23 +11,21 @@ namespace ecs::tag {
 	struct event; /* a callback that executes attached listeners */
 	struct monolith; /* a data point unassociated with other components */
 	struct asset; /* a data point with a built handle management. */
-
-	// TODO:
-	// template<typename ... Ts> struct archetype : component { };
-	// template<typename ... Ts> struct uniontype : component { };
+	template<typename ... Ts> struct archetype; /* a component storing a fixed set of values in parallel columns */
+	template<typename ... Ts> struct uniontype; /* a component storing one of several alternative values */
 }
 
 namespace ecs::policy {
 	// execution policy
 	struct immediate { }; // executes operation immediately.
 	struct deferred { }; // defers operation until sync, does not modify primary structure.
-	// ??? struct lazy { }; // reorders primary structures but waits until sync to call events or modify storage.
 
 	// sequence policy
 	struct optimal; // uses swap and insert or swap and pop to insert/erase component. 
 	struct strict; // maintains the order of components.
-	// ??? struct grouped { }; // maintains the order of components.
-	// ??? struct sorted { }; // maintains the order of components.
+	template<typename ... Ts> struct grouped; // packs entities owning every component in Ts at the front of each pool.
+	template<typename cmp_T> struct sorted; // maintains the order of components by comparing component values.
+	struct lazy; // leaves a tombstone on erase, storage is compacted and terminate events called on compact.
 }
 
 namespace ecs::traits {
@@ -71,6 +69,15 @@ namespace ecs {
 	template<ecs::traits::component_class T> struct manager;
 	template<ecs::traits::component_class T> struct indexer;
 	template<ecs::traits::component_class T> struct storage;
+	template<ecs::traits::component_class T> struct column_storage;
+	template<ecs::traits::component_class ... Ts> struct group;
+	template<ecs::traits::component_class T> struct free_list;
+	template<ecs::traits::component_class T> struct tracker;
+	template<ecs::traits::component_class T> struct presence;
+	template<ecs::traits::component_class T> struct library;
+	template<ecs::traits::component_class T> struct command_buffer;
+	template<ecs::traits::component_class T> struct graveyard;
+	template<ecs::traits::component_class T> struct alignment;
 
 	// components
 	template<ecs::traits::event_class T> struct listener;
@@ -81,6 +88,7 @@ namespace ecs {
 		template<traits::entity_class T, typename reg_T=registry<>> struct destroy;
 		template<traits::component_class T, typename reg_T=registry<>> struct initialize;
 		template<traits::component_class T, typename reg_T=registry<>> struct terminate;
+		template<traits::component_class T, typename reg_T=registry<>> struct update;
 	}
 
 	// services
@@ -98,6 +106,9 @@ namespace ecs {
 	// view decorators
 	template<traits::component_class ... Ts> struct inc;
 	template<traits::component_class ... Ts> struct exc;
+	template<traits::component_class ... Ts> struct added;
+	template<traits::component_class ... Ts> struct changed;
+	template<traits::component_class T, typename ... alt_Ts> struct holds;
 	// ? template<traits::component_class T> struct cnd;
 
 	template<typename ... Ts> struct select { };
@@ -3,6 +3,8 @@
 #include "core/fwd.h"
 #include <util.h>
 #include <cstdint>
+#include <variant>
+#include <string>
 
 #ifndef ECS_RECURSIVE_DEPENDENCY
 #define ECS_RECURSIVE_DEPENDENCY true
@@ -30,6 +32,11 @@
 #define ECS_DEFAULT_PAGE_SIZE 4096
 #endif
 
+/* the default integral the indexer maps handles to if component does not declare index_type  */
+#ifndef ECS_DEFAULT_INDEX
+#define ECS_DEFAULT_INDEX std::size_t
+#endif
+
 /* the default mutex used if attribute does not declare mutex_type  */
 #ifndef ECS_DEFAULT_MUTEX
 #define ECS_DEFAULT_MUTEX ecs::priority_mutex
@@ -50,6 +57,11 @@
 #define ECS_DEFAULT_TERMINATE_EVENT ecs::event::terminate<T>
 #endif
  
+/* the default update event used if component does not declare update_event  */
+#ifndef ECS_DEFAULT_UPDATE_EVENT  
+#define ECS_DEFAULT_UPDATE_EVENT ecs::event::update<T>
+#endif
+ 
 /* the default create event used if entity does not declare create_event  */
 #ifndef ECS_DEFAULT_CREATE_EVENT
 #define ECS_DEFAULT_CREATE_EVENT ecs::event::create<T>
@@ -185,6 +197,10 @@ namespace ecs::traits::component {
 	TRAIT_TYPE(terminate_event, terminate_event, component)
 	TRAIT_ATTRIB_TYPE(terminate_event, terminate_event)
 
+	/* the event fired when components are patched in place */
+	TRAIT_TYPE(update_event, update_event, component)
+	TRAIT_ATTRIB_TYPE(update_event, update_event)
+
 	template<traits::component_class T>
 	struct get_handle;
 	template<traits::component_class T> requires (!std::is_void_v<get_entity_t<T>>)
@@ -206,9 +222,74 @@ namespace ecs::traits::component {
 	TRAIT_TYPE(storage, storage_type, component)
 	TRAIT_ATTRIB_TYPE(storage, storage_type)
 
+	/* the reference returned on access to a component value, storage may return a proxy reference. */
+	template<traits::component_class T>
+	struct get_reference { using type = std::add_lvalue_reference_t<util::copy_const_t<get_value_t<T>, T>>; };
+	template<traits::component_class T> requires (!std::is_void_v<get_storage_t<T>>)
+	struct get_reference<T> { 
+		using container_type = ecs::traits::attribute::get_value_t<std::remove_const_t<get_storage_t<T>>>;
+		using type = std::conditional_t<std::is_const_v<T>, typename container_type::const_reference, typename container_type::reference>;
+	};
+	template<traits::component_class T>
+	using get_reference_t = typename get_reference<T>::type;
+
+	/* the unsigned integral the indexer maps handles to, bounds the number of components in the pool. */
+	TRAIT_TYPE(index, index_type, component)
+	TRAIT_ATTRIB_TYPE(index, index_type)
+
+	/* when enabled the indexer stores the handle beside the index and rejects stale versions of the entity index. */
+	TRAIT_VALUE(bool, version_checked, version_checked, component)
+	TRAIT_ATTRIB_VALUE(bool, version_checked, version_checked)
+
 	/* the storage attribute stores the component value_type corresponding to the entity. */
 	TRAIT_VALUE(std::size_t, page_size, page_size, component)
 	TRAIT_ATTRIB_VALUE(std::size_t, page_size, page_size)
+
+	/* when enabled erase leaves a tombstone in place and the slot is reused by a later emplace, references remain valid. */
+	TRAIT_VALUE(bool, pointer_stable, pointer_stable, component)
+	TRAIT_ATTRIB_VALUE(bool, pointer_stable, pointer_stable)
+
+	/* the free list attribute stores the vacant indices of a pointer stable pool. */
+	TRAIT_TYPE(free_list, free_list_type, component)
+
+	/* when enabled the pool stamps each element with the tick it was added and last modified at. */
+	TRAIT_VALUE(bool, change_tracking, change_tracking, component)
+	TRAIT_ATTRIB_VALUE(bool, change_tracking, change_tracking)
+
+	/* the tracker attribute stores the current tick and the per-element tick column of a change tracking pool. */
+	TRAIT_TYPE(tracker, tracker_type, component)
+
+	/* when enabled the pool maintains a bitmap of the entity indices holding the component, views test it before the indexer. */
+	TRAIT_VALUE(bool, presence_bitmap, presence_bitmap, component)
+	TRAIT_ATTRIB_VALUE(bool, presence_bitmap, presence_bitmap)
+
+	/* the presence attribute stores the bitmap of a pool with presence_bitmap enabled. */
+	TRAIT_TYPE(presence, presence_type, component)
+
+	/* the command buffer attribute records the operations deferred until sync. */
+	TRAIT_TYPE(command_buffer, command_buffer_type, component)
+	TRAIT_ATTRIB_TYPE(command_buffer, command_buffer_type)
+
+	/* the graveyard attribute stores the tombstones left by the lazy sequence policy until compacted. */
+	TRAIT_TYPE(graveyard, graveyard_type, component)
+
+	/* the alignment attribute stores the length of the prefix ordered by sort_as. */
+	TRAIT_TYPE(alignment, alignment_type, component)
+
+	/* the key an asset is deduplicated by. */
+	TRAIT_TYPE(key, key_type, component)
+	TRAIT_ATTRIB_TYPE(key, key_type)
+
+	/* the library attribute stores the key lookup and reference counts of an asset. */
+	TRAIT_TYPE(library, library_type, component)
+
+	/* the sequence policy determines the default order of component-entity pairs within the pool. */
+	TRAIT_TYPE(sequence_policy, sequence_policy, component)
+	TRAIT_ATTRIB_TYPE(sequence_policy, sequence_policy)
+
+	/* the group attribute declared by the sequence policy, stores the shared state of grouped pools. */
+	TRAIT_TYPE(group, group_type, component)
+	TRAIT_ATTRIB_TYPE(group, group_type)
 }
 
 namespace ecs::traits::event {
@@ -311,6 +392,7 @@ namespace ecs::tag {
 		using value_type = void;
 		using initialize_event = void;
 		using terminate_event = void;
+		using update_event = void;
 		using storage_type = void;
 		using manager_type = void;
 	};
@@ -318,8 +400,33 @@ namespace ecs::tag {
 	struct monolith : component {
 		using entity_type = void;
 	};
+
+	struct asset : component {
+		using entity_type = void; // referenced by its own handle, created on load
+	};
+
+	template<typename ... Ts>
+	struct archetype : component {
+		using value_type = std::tuple<Ts...>;
+	};
+
+	template<typename ... Ts>
+	struct uniontype : component {
+		using value_type = std::variant<Ts...>;
+	};
 };
 
+namespace ecs::traits {
+	/* true if the category tag stores its values in parallel columns by default. */
+	template<typename T> struct is_archetype : std::false_type { };
+	template<typename ... Ts> struct is_archetype<tag::archetype<Ts...>> : std::true_type { };
+	template<typename T> static constexpr bool is_archetype_v = is_archetype<T>::value;
+
+	/* true if the category tag deduplicates and reference counts its handles. */
+	template<typename T> struct is_asset : std::is_base_of<tag::asset, T> { };
+	template<typename T> static constexpr bool is_asset_v = is_asset<T>::value;
+}
+
 namespace ecs {	
 	template<typename T, typename tag_T>
 	struct attribute_traits {
@@ -354,11 +461,34 @@ namespace ecs {
 
 		using manager_type = traits::component::get_trait_manager_t<T, traits::component::get_trait_manager_t<tag_T, manager<T>>>;
 		using indexer_type = traits::component::get_trait_indexer_t<T, traits::component::get_trait_indexer_t<tag_T, indexer<T>>>;
-		using storage_type = traits::component::get_trait_storage_t<T, traits::component::get_trait_storage_t<tag_T, std::conditional_t<(std::is_empty_v<value_type> || std::is_void_v<value_type>), void, storage<T>>>>;
+		using storage_type = traits::component::get_trait_storage_t<T, traits::component::get_trait_storage_t<tag_T, std::conditional_t<(std::is_empty_v<value_type> || std::is_void_v<value_type>), void, std::conditional_t<traits::is_archetype_v<tag_T>, column_storage<T>, storage<T>>>>>;
+		using update_event = traits::component::get_trait_update_event_t<T, traits::component::get_trait_update_event_t<tag_T, std::conditional_t<std::is_void_v<storage_type>, void, ECS_DEFAULT_UPDATE_EVENT>>>;
 
+		using sequence_policy = traits::component::get_trait_sequence_policy_t<T, traits::component::get_trait_sequence_policy_t<tag_T, ecs::policy::optimal>>;
+		using group_type = traits::component::get_trait_group_t<sequence_policy, void>;
+
+		using index_type = traits::component::get_trait_index_t<T, traits::component::get_trait_index_t<tag_T, ECS_DEFAULT_INDEX>>;
+		static constexpr bool version_checked = traits::component::get_trait_version_checked_v<T, traits::component::get_trait_version_checked_v<tag_T, false>>;
 		static constexpr std::size_t page_size = traits::component::get_trait_page_size_v<T, traits::component::get_trait_page_size_v<tag_T, ECS_DEFAULT_PAGE_SIZE>>;
+		static constexpr bool pointer_stable = traits::component::get_trait_pointer_stable_v<T, traits::component::get_trait_pointer_stable_v<tag_T, false>>;
+		
+		using free_list_type = std::conditional_t<pointer_stable, free_list<T>, void>;
+
+		static constexpr bool change_tracking = traits::component::get_trait_change_tracking_v<T, traits::component::get_trait_change_tracking_v<tag_T, false>>;
+		
+		using tracker_type = std::conditional_t<change_tracking, tracker<T>, void>;
+
+		static constexpr bool presence_bitmap = traits::component::get_trait_presence_bitmap_v<T, traits::component::get_trait_presence_bitmap_v<tag_T, false>>;
+
+		using presence_type = std::conditional_t<presence_bitmap, presence<T>, void>;
+
+		using key_type = traits::component::get_trait_key_t<T, traits::component::get_trait_key_t<tag_T, std::string>>;
+		using library_type = std::conditional_t<traits::is_asset_v<tag_T>, library<T>, void>;
+		using graveyard_type = std::conditional_t<std::is_same_v<sequence_policy, ecs::policy::lazy>, graveyard<T>, void>;
+		using command_buffer_type = traits::component::get_trait_command_buffer_t<T, traits::component::get_trait_command_buffer_t<tag_T, std::conditional_t<std::is_void_v<manager_type>, void, command_buffer<T>>>>;
+		using alignment_type = std::conditional_t<std::is_void_v<manager_type>, void, alignment<T>>;
 
-		using dependency_set = util::push_back_t<traits::dependencies::get_trait_dependencies_t<T, traits::dependencies::get_trait_dependencies_t<tag_T, std::tuple<>>>, initialize_event, terminate_event, entity_type, manager_type, indexer_type, storage_type>;
+		using dependency_set = util::push_back_t<traits::dependencies::get_trait_dependencies_t<T, traits::dependencies::get_trait_dependencies_t<tag_T, std::tuple<>>>, initialize_event, terminate_event, update_event, entity_type, manager_type, indexer_type, storage_type, group_type, free_list_type, tracker_type, presence_type, library_type, command_buffer_type, graveyard_type, alignment_type>;
 	};
 
 	template<typename T, typename tag_T>
@@ -12,6 +12,7 @@ namespace ecs {
 		using value_type = void;
 		using initialize_event = void;
 		using terminate_event = void;
+		using update_event = void;
 	};
 
 	template<ecs::traits::event_class T, typename reg_T>
@@ -56,6 +57,11 @@ namespace ecs {
 			reg.template erase<listener_type, seq_T>(callback);
 		}
 	
+		/* returns true if no listener is attached, invoke would be a no-op. */
+		[[nodiscard]] constexpr bool empty() const {
+			return reg.template pool<listener_type>().size() == 0;
+		}
+
 		constexpr void clear() {
 			reg.template pool<listener_type>().clear();
 
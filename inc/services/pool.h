@@ -2,6 +2,13 @@
 #include "core/traits.h"
 #include <cassert>
 #include <span>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <functional>
+#include <ranges>
+#include <limits>
+#include <stdexcept>
 
 namespace ecs {
 	template<ecs::traits::component_class T, typename reg_T>
@@ -17,20 +24,37 @@ namespace ecs {
 
 		using initialize_event = traits::component::get_initialize_event_t<component_type>;
 		using terminate_event = traits::component::get_terminate_event_t<component_type>;
+		using update_event = traits::component::get_update_event_t<component_type>;
+		using sequence_policy = traits::component::get_sequence_policy_t<component_type>;
+		using index_type = traits::component::get_index_t<component_type>;
 		
 		using manager_type = util::copy_const_t<traits::component::get_manager_t<component_type>, T>;
 		using indexer_type = util::copy_const_t<traits::component::get_indexer_t<component_type>, T>;
 		using storage_type = util::copy_const_t<traits::component::get_storage_t<component_type>, T>;
+		using free_list_type = util::copy_const_t<traits::component::get_free_list_t<component_type>, T>;
+		using tracker_type = util::copy_const_t<traits::component::get_tracker_t<component_type>, T>;
+		using presence_type = util::copy_const_t<traits::component::get_presence_t<component_type>, T>;
+		using command_buffer_type = util::copy_const_t<traits::component::get_command_buffer_t<component_type>, T>;
+		using graveyard_type = util::copy_const_t<traits::component::get_graveyard_t<component_type>, T>;
+		using alignment_type = util::copy_const_t<traits::component::get_alignment_t<component_type>, T>;
 
-		using reference = std::add_lvalue_reference_t<value_type>;
-		using const_reference = std::add_lvalue_reference_t<const value_type>;
+		using reference = traits::component::get_reference_t<T>;
+		using const_reference = traits::component::get_reference_t<const component_type>;
 
 		static constexpr bool initialize_event_enabled = !std::is_void_v<initialize_event>;
 		static constexpr bool terminate_event_enabled = !std::is_void_v<terminate_event>;
+		static constexpr bool update_event_enabled = !std::is_void_v<update_event>;
 		
 		static constexpr bool manager_enabled = !std::is_void_v<manager_type>;
 		static constexpr bool indexer_enabled = !std::is_void_v<indexer_type>;
 		static constexpr bool storage_enabled = !std::is_void_v<storage_type>;
+		static constexpr bool pointer_stable = traits::component::get_pointer_stable_v<component_type>;
+		static constexpr bool tracker_enabled = !std::is_void_v<tracker_type>;
+		static constexpr bool presence_enabled = !std::is_void_v<presence_type>;
+		static constexpr bool command_buffer_enabled = !std::is_void_v<command_buffer_type>;
+		static constexpr bool lazy_enabled = !std::is_void_v<graveyard_type>;
+		static constexpr bool sorted_enabled = requires { typename sequence_policy::compare_type; };
+		static constexpr bool version_checked = manager_enabled && traits::component::get_version_checked_v<component_type>; // the indexer is a versioned_sparse, stale versions are rejected and never overwritten
 
 		// attributes cannot be shared
 		static_assert(!manager_enabled || !indexer_enabled || !std::is_same_v<manager_type, indexer_type>);
@@ -41,6 +65,15 @@ namespace ecs {
 		static_assert(!storage_enabled || manager_enabled , "storage enabled but manager disabled. storage requires manager attribute.");
 		static_assert(!terminate_event_enabled || manager_enabled, "terminate event enabled but manager disabled. Events require manager attribute.");
 		static_assert(!initialize_event_enabled || manager_enabled, "initialize event enabled but manager disabled. Events require manager attribute.");
+		static_assert(!pointer_stable || manager_enabled, "pointer stable but manager disabled. tombstones require manager attribute.");
+		static_assert(!tracker_enabled || manager_enabled, "change tracking enabled but manager disabled. tick column requires manager attribute.");
+		static_assert(!lazy_enabled || manager_enabled, "lazy policy but manager disabled. tombstones require manager attribute.");
+		static_assert(!lazy_enabled || !pointer_stable, "lazy policy and pointer stable are exclusive. tombstones are either compacted or reused.");
+		static_assert(!pointer_stable || (!sorted_enabled && !requires { typename sequence_policy::group_type; }), "pointer stable with a sorted or grouped policy. tombstone slots are reused in place, the policy cannot position insertions.");
+		static_assert(!pointer_stable || !storage_enabled || std::is_default_constructible_v<value_type>, "pointer stable requires a default constructible value. an erased value is reset to release its resources, a reused slot is assigned.");
+		static_assert(!requires { typename sequence_policy::group_type; } || traits::is_grouped_v<sequence_policy, component_type>, "grouped policy does not list the component. the pool cannot share the order of the group.");
+		static_assert(traits::is_group_shared_v<sequence_policy, traits::component::get_sequence_policy_t>, "grouped policy not declared by every component in the group. the pools must share their order.");
+		static_assert(!presence_enabled || std::is_convertible_v<handle_type, std::size_t>, "presence bitmap enabled but handle has no entity index. bits are keyed by the index of the handle.");
 
 		constexpr pool(reg_T& reg) noexcept : reg(reg) { }
 	
@@ -50,13 +83,33 @@ namespace ecs {
 			return manager.size();
 		}
 
+		/** returns the largest number of components the index_type of the indexer addresses, the maximum value itself is reserved as the sparse tombstone */
+		[[nodiscard]] static constexpr std::size_t max_size() noexcept {
+			return std::numeric_limits<index_type>::max();
+		}
+
 		constexpr void reserve(std::size_t n) const {
 			if constexpr (manager_enabled) {
 				reg.template get_attribute<manager_type>().reserve(n);
 			}
 
-			if constexpr (storage_enabled) {
-				reg.template get_attribute<storage_type>().reserve(n);
+			for_each_column([&](auto& column) { column.reserve(n); });
+		}
+
+		/** releases the unused capacity of the manager and the columns stored parallel to it */
+		constexpr void shrink() const {
+			if constexpr (manager_enabled) {
+				reg.template get_attribute<manager_type>().shrink_to_fit();
+			}
+
+			for_each_column([&](auto& column) { column.shrink_to_fit(); });
+
+			if constexpr (pointer_stable) {
+				reg.template get_attribute<free_list_type>().shrink_to_fit();
+			}
+
+			if constexpr (lazy_enabled) {
+				reg.template get_attribute<graveyard_type>().shrink_to_fit();
 			}
 		}
 
@@ -136,8 +189,22 @@ namespace ecs {
 
 		/** returns true if entity exists within the pool */
 		[[nodiscard]] constexpr bool contains(const handle_type& hnd) const requires (indexer_enabled) {
+			if constexpr (presence_enabled) {
+				if (!present(hnd)) return false; // rejects absent entities without the indexer lookup
+			}
+
 			const auto& indexer = reg.template get_attribute<const indexer_type>();
-			return indexer.contains(hnd);
+			return indexer.contains(hnd); // a version checked indexer rejects stale versions of the entity index
+		}
+
+		/** returns true if an entity with the index of the handle holds the component, the version is not compared */
+		[[nodiscard]] constexpr bool present(const handle_type& hnd) const requires (presence_enabled) {
+			return reg.template get_attribute<const presence_type>().test(std::size_t(hnd));
+		}
+
+		/** returns the bitmap of the entity indices holding the component */
+		[[nodiscard]] constexpr const ecs::bitmap& presence() const requires (presence_enabled) {
+			return reg.template get_attribute<const presence_type>();
 		}
 
 		/** returns the index of the component of a given entity */
@@ -150,25 +217,160 @@ namespace ecs {
 			return -1;
 		}
 
+		/** returns the component and marks it changed */
+		[[nodiscard]] constexpr reference modify(const handle_type& hnd) requires (indexer_enabled && storage_enabled) {
+			std::size_t idx = index_of(hnd);
+			if constexpr (tracker_enabled) {
+				auto& tracker = reg.template get_attribute<tracker_type>();
+				tracker.column[idx].changed = tracker.tick;
+			}
+			return component_at(idx);
+		}
+
+		/** applies fn to the component of the entity in place, marks it changed and calls the update event */
+		template<typename fn_T>
+		constexpr void patch(const handle_type& hnd, fn_T&& fn) requires (indexer_enabled && storage_enabled) {
+			std::invoke(fn, modify(hnd));
+
+			if constexpr (sorted_enabled && manager_enabled) {
+				reposition(index_of(hnd)); // the patched value may have changed its key
+			}
+
+			if constexpr (update_event_enabled) {
+				reg.template on<update_event>().invoke(reg, std::span<const handle_type>(&hnd, 1));
+			}
+		}
+
+		/** applies fn to the component of each entity in place, called with the handle and component or the component alone. calls a single update event carrying every patched handle */
+		template<typename fn_T>
+		constexpr void patch(std::span<const handle_type> hnds, fn_T&& fn) requires (indexer_enabled && storage_enabled) {
+			for (const auto& hnd : hnds) {
+				if constexpr (std::is_invocable_v<fn_T&, const handle_type&, reference>) {
+					std::invoke(fn, hnd, modify(hnd));
+				} else {
+					std::invoke(fn, modify(hnd));
+				}
+			}
+
+			if constexpr (sorted_enabled && manager_enabled) {
+				sort(); // the patched values may have changed their keys
+			}
+
+			if constexpr (update_event_enabled) {
+				if (!hnds.empty()) {
+					reg.template on<update_event>().invoke(reg, hnds);
+				}
+			}
+		}
+
+		/** returns true if the component at the index was added within the current tick */
+		[[nodiscard]] constexpr bool added_at(std::size_t idx) const requires (tracker_enabled) {
+			const auto& tracker = reg.template get_attribute<const tracker_type>();
+			return tracker.column[idx].added == tracker.tick;
+		}
+
+		/** returns true if the component at the index was added or modified within the current tick */
+		[[nodiscard]] constexpr bool changed_at(std::size_t idx) const requires (tracker_enabled) {
+			const auto& tracker = reg.template get_attribute<const tracker_type>();
+			return tracker.column[idx].changed == tracker.tick;
+		}
+
+		/** returns true if the component of the entity was added within the current tick */
+		[[nodiscard]] constexpr bool added(const handle_type& hnd) const requires (tracker_enabled) {
+			std::size_t idx = index_of(hnd);
+			return idx != static_cast<std::size_t>(-1) && added_at(idx);
+		}
+
+		/** returns true if the component of the entity was added or modified within the current tick */
+		[[nodiscard]] constexpr bool changed(const handle_type& hnd) const requires (tracker_enabled) {
+			std::size_t idx = index_of(hnd);
+			return idx != static_cast<std::size_t>(-1) && changed_at(idx);
+		}
+
+		/** starts a new tick, components added or modified before are no longer reported as added or changed */
+		constexpr void advance_tick() requires (tracker_enabled) {
+			++reg.template get_attribute<tracker_type>().tick;
+		}
+
 		/** adds a component to the back of the pool */
-		template<typename ... arg_Ts> requires (!storage_enabled || std::is_constructible_v<value_type, arg_Ts...>)
+		template<typename seq_T=sequence_policy, typename ... arg_Ts> requires (!storage_enabled || std::is_constructible_v<value_type, arg_Ts...>)
 		constexpr decltype(auto) emplace_back(handle_type hnd, arg_Ts&&... args) {
+			if constexpr (version_checked) {
+				evict(hnd);
+			}
 			assert(!contains(hnd));
-			assert(reg.alive(hnd));
+			if constexpr (!std::is_void_v<entity_type>) {
+				assert(reg.alive(hnd));
+			}
 
 			auto& indexer = reg.template get_attribute<indexer_type>();
+			seq_T policy;
 			
 			if constexpr (manager_enabled) {
 				auto& manager = reg.template get_attribute<manager_type>();
+
+				if constexpr (pointer_stable) {
+					auto& vacancies = reg.template get_attribute<free_list_type>();
+					
+					if (!vacancies.empty()) { // reuse tombstone
+						std::size_t idx = vacancies.back();
+						vacancies.pop_back();
+
+						manager[idx] = hnd;
+						indexer.emplace(hnd, idx);
+						mark(hnd);
+
+						if constexpr (tracker_enabled) {
+							auto& tracker = reg.template get_attribute<tracker_type>();
+							tracker.column[idx] = change_ticks{ tracker.tick, tracker.tick };
+						}
+
+						if constexpr (storage_enabled) {
+							auto& storage = reg.template get_attribute<storage_type>();
+							storage[idx] = value_type(std::forward<arg_Ts>(args)...);
+							
+							reference val = storage[idx];
+
+							if constexpr (initialize_event_enabled) {
+								reg.template on<initialize_event>().invoke(reg, hnd, val);
+							}
+
+							return val;
+						} else {
+							if constexpr (initialize_event_enabled) {
+								reg.template on<initialize_event>().invoke(reg, hnd);
+							}
+
+							return;
+						}
+					}
+				}
 				
+				check_capacity(1);
 				manager.emplace_back(hnd);
 				
-				indexer.emplace(hnd, indexer.size());
+				indexer.emplace(hnd, manager.size() - 1);
+				mark(hnd);
+
+				if constexpr (tracker_enabled) {
+					auto& tracker = reg.template get_attribute<tracker_type>();
+					tracker.column.emplace_back(tracker.tick, tracker.tick);
+				}
 
 				if constexpr (storage_enabled) {
 					auto& storage = reg.template get_attribute<storage_type>();
 					
-					auto& val = storage.emplace_back(std::forward<arg_Ts>(args)...);
+					storage.emplace_back(std::forward<arg_Ts>(args)...);
+
+					if constexpr (requires { typename seq_T::compare_type; }) {
+						sort_back(policy);
+					}
+
+					if constexpr (requires { policy.enter(reg, hnd); }) {
+						policy.enter(reg, hnd);
+					}
+
+					reference val = component_at(index_of(hnd));
 
 					if constexpr (initialize_event_enabled) {
 						reg.template on<initialize_event>().invoke(reg, hnd, val);
@@ -176,79 +378,131 @@ namespace ecs {
 
 					return val;
 				} else {
+					if constexpr (requires { policy.enter(reg, hnd); }) {
+						policy.enter(reg, hnd);
+					}
+
 					if constexpr (initialize_event_enabled) {
 						reg.template on<initialize_event>().invoke(reg, hnd);
 					}
 				}
 			} else {
 				indexer.emplace(hnd);
+				mark(hnd);
 			}
 		}
 
-		/** adds a component to the back of the pool */
-		template<typename ... arg_Ts> requires (!storage_enabled || std::is_constructible_v<value_type, arg_Ts...>)
+		/** adds a component constructed from the same args to the back of the pool for each handle */
+		template<typename seq_T=sequence_policy, typename ... arg_Ts> requires (!storage_enabled || std::is_constructible_v<value_type, arg_Ts&...>)
 		constexpr void emplace_back(std::span<handle_type> hnds, arg_Ts&&... args) {
-			auto& indexer = reg.template get_attribute<indexer_type>();
-			
-			if constexpr (manager_enabled) { // manager
-				auto& manager = reg.template get_attribute<manager_type>();
-
-				manager.reserve(manager.size() + hnds.size());
-				
-				for (std::size_t i = 0; i < hnds.size(); ++i) {
-					manager.emplace_back(hnds[i]);
-				}
-				
-				for (std::size_t i = 0; i < hnds.size(); ++i) {
-					indexer.emplace(hnds[i], indexer.size());
-				}
+			seq_T policy;
 
-				if constexpr (storage_enabled) {
-					auto& storage = reg.template get_attribute<storage_type>();
-					storage.reserve(storage.size() + hnds.size());
-					
+			if constexpr (!manager_enabled) {
+				auto& indexer = reg.template get_attribute<indexer_type>();
+				for (auto& hnd : hnds) { indexer.emplace(hnd); mark(hnd); }
+			} else if constexpr (pointer_stable || requires { typename seq_T::compare_type; } || requires { policy.enter(reg, hnds[0]); }) { // each insertion is positioned by the policy
+				for (auto& hnd : hnds) emplace_back<seq_T>(hnd, args...);
+			} else {
+				append(hnds, [&](auto& storage) {
 					for (std::size_t i = 0; i < hnds.size(); ++i) {
-						storage.emplace_back(std::forward<arg_Ts>(args)...);
+						storage.emplace_back(args...); // not forwarded, each value is constructed from the same args
 					}
+				});
+			}
+		}
 
-					if constexpr (initialize_event_enabled) {
-						auto it = storage.end() - hnds.size();
-						for (std::size_t i = 0; i < hnds.size(); ++i) {
-							reg.template on<initialize_event>().invoke(reg, hnds[i], *it++);
-						}
-					}	
-				} else {
-					if constexpr (initialize_event_enabled) {
-						for (std::size_t i = 0; i < hnds.size(); ++i) {
-							reg.template on<initialize_event>().invoke(reg, hnds[i]);
-						}
+		/** adds a component to the back of the pool for each handle, moved or copied from the corresponding element of values */
+		template<typename seq_T=sequence_policy, std::ranges::input_range R> requires (storage_enabled && std::ranges::sized_range<R> && std::is_constructible_v<value_type, std::ranges::range_reference_t<R>> && !std::is_constructible_v<value_type, R&>)
+		constexpr void emplace_back(std::span<handle_type> hnds, R&& values) {
+			assert(std::ranges::size(values) == hnds.size());
+			seq_T policy;
+
+			if constexpr (pointer_stable || requires { typename seq_T::compare_type; } || requires { policy.enter(reg, hnds[0]); }) { // each insertion is positioned by the policy
+				constexpr bool movable = !std::is_lvalue_reference_v<R> && !std::ranges::view<std::remove_cvref_t<R>>;
+				auto it = std::ranges::begin(values);
+				for (std::size_t i = 0; i < hnds.size(); ++i, ++it) {
+					if constexpr (movable) {
+						emplace_back<seq_T>(hnds[i], std::move(*it));
+					} else {
+						emplace_back<seq_T>(hnds[i], *it);
 					}
 				}
 			} else {
+				append(hnds, [&](auto& storage) { storage.append_range(std::forward<R>(values)); });
+			}
+		}
+
+		/** adds a component to the back of the pool for each handle, constructed from fn(handle, i) where i is the position of the handle in hnds */
+		template<typename seq_T=sequence_policy, typename fn_T> requires (storage_enabled && std::is_invocable_v<fn_T&, const handle_type&, std::size_t> && !std::is_constructible_v<value_type, fn_T&>)
+		constexpr void emplace_back(std::span<handle_type> hnds, fn_T&& fn) {
+			seq_T policy;
+
+			if constexpr (pointer_stable || requires { typename seq_T::compare_type; } || requires { policy.enter(reg, hnds[0]); }) { // each insertion is positioned by the policy
 				for (std::size_t i = 0; i < hnds.size(); ++i) {
-					indexer.emplace(hnds[i]);
+					emplace_back<seq_T>(hnds[i], std::invoke(fn, hnds[i], i));
 				}
+			} else {
+				append(hnds, [&](auto& storage) {
+					for (std::size_t i = 0; i < hnds.size(); ++i) {
+						storage.emplace_back(std::invoke(fn, hnds[i], i));
+					}
+				});
 			}
 		}
 		
+		/** adds the handles to the back of the pool, adopting pages of values built outside the pool without copying. pages are allocated by the storage's allocator and hold a value for each handle in order.
+		    the pool size must be a multiple of the page size else std::invalid_argument is thrown before the pages are taken, the indexer is built in one pass and initialize events are called once every handle is adopted */
+		template<typename seq_T=sequence_policy>
+		constexpr void adopt(std::span<const handle_type> hnds, const auto& pages) requires (manager_enabled && storage_enabled) {
+			seq_T policy;
+			static_assert(!pointer_stable && !requires { typename seq_T::compare_type; } && !requires { policy.enter(reg, hnds[0]); }, "adopt appends to the back, the policy must not position insertions.");
+
+			if constexpr (version_checked) {
+				for (const auto& hnd : hnds) evict(hnd); // erasing a stale version moves values, the adopted pages must not be touched
+			}
+			check_capacity(hnds.size()); // before the storage takes ownership of the pages
+
+			auto& storage = reg.template get_attribute<storage_type>();
+			assert(storage.size() == size());
+			storage.adopt(pages, hnds.size());
+			append(hnds, [](auto& storage) { }); // the storage already holds the adopted values
+		}
+
 		/** adds a component to the pool at the index */
-		template<typename seq_T=policy::optimal, typename ... arg_Ts> requires (manager_enabled && (!storage_enabled || std::is_constructible_v<value_type, arg_Ts...>))
+		template<typename seq_T=sequence_policy, typename ... arg_Ts> requires (manager_enabled && (!storage_enabled || std::is_constructible_v<value_type, arg_Ts...>))
 		constexpr decltype(auto) emplace_at(std::size_t idx, handle_type hnd, arg_Ts&&... args) {
 			auto& manager = reg.template get_attribute<manager_type>();
 			auto& indexer = reg.template get_attribute<indexer_type>();
 			seq_T policy;
 
+			if constexpr (pointer_stable || lazy_enabled || requires { policy.enter(reg, hnd); } || requires { typename seq_T::compare_type; }) { // position is determined by the policy
+				return emplace_back<seq_T>(hnd, std::forward<arg_Ts>(args)...);
+			}
+
+			if constexpr (version_checked) {
+				evict(hnd);
+				idx = std::min(idx, manager.size());
+			}
+
+			check_capacity(1);
 			manager.reserve(manager.size() + 1);
 
 			auto pos = manager.begin() + idx;
 			auto update = policy.emplace(manager, pos, hnd);
 
 			indexer.emplace(hnd, std::distance(manager.begin(), pos));
+			mark(hnd);
 			
 			for (auto it = update.begin(), end = manager.end(); it < end; ++it) {
 				indexer.at(*it) = std::distance(manager.begin(), it);
 			}
 
+			if constexpr (tracker_enabled) {
+				auto& tracker = reg.template get_attribute<tracker_type>();
+				tracker.column.reserve(tracker.column.size() + 1);
+				policy.emplace(tracker.column, tracker.column.begin() + idx, change_ticks{ tracker.tick, tracker.tick });
+			}
+
 			if constexpr (storage_enabled) {
 				auto& storage = reg.template get_attribute<storage_type>();
 				storage.reserve(storage.size() + 1);
@@ -268,46 +522,166 @@ namespace ecs {
 		}
 
 		/** adds a component to the pool at the index */
-		template<typename seq_T=policy::optimal, typename ... arg_Ts> requires (manager_enabled && (!storage_enabled || std::is_constructible_v<value_type, arg_Ts...>))
+		template<typename seq_T=sequence_policy, typename ... arg_Ts> requires (manager_enabled && (!storage_enabled || std::is_constructible_v<value_type, arg_Ts...>))
 		constexpr void emplace_at(std::size_t idx, std::span<handle_type> hnds, arg_Ts&&... args) {
 			auto& manager = reg.template get_attribute<manager_type>();
 			auto& indexer = reg.template get_attribute<indexer_type>();
 			seq_T policy;
 
+			if constexpr (pointer_stable || lazy_enabled || requires { policy.enter(reg, hnds[0]); } || requires { typename seq_T::compare_type; }) { // position is determined by the policy
+				return emplace_back<seq_T>(hnds, std::forward<arg_Ts>(args)...);
+			}
+
+			if constexpr (version_checked) {
+				for (const auto& hnd : hnds) evict(hnd);
+				idx = std::min(idx, manager.size());
+			}
+
+			check_capacity(hnds.size());
 			manager.reserve(manager.size() + hnds.size());
 
 			auto pos = manager.begin() + idx;
-			auto update = policy.insert_range(manager, hnds);
+			auto update = policy.insert_range(manager, pos, hnds);
 
 			for (auto it = pos, end = it + hnds.size(); it < end; ++it) {
 				indexer.emplace(*it, std::distance(manager.begin(), it));
+				mark(*it);
 			}
 			
-			for (auto it = update, end = manager.end(); it < end; ++it) {
+			for (auto it = update.begin(), end = manager.end(); it < end; ++it) {
 				indexer.at(*it) = std::distance(manager.begin(), it);
 			}
 
+			if constexpr (tracker_enabled) {
+				auto& tracker = reg.template get_attribute<tracker_type>();
+				tracker.column.reserve(tracker.column.size() + hnds.size());
+				policy.emplace_n(tracker.column, tracker.column.begin() + idx, hnds.size(), change_ticks{ tracker.tick, tracker.tick });
+			}
+
 			if constexpr (storage_enabled) {
 				auto& storage = reg.template get_attribute<storage_type>();
 				storage.reserve(storage.size() + hnds.size());
 				policy.emplace_n(storage, storage.begin() + idx, hnds.size(), std::forward<arg_Ts>(args)...);
 			
 				if constexpr (initialize_event_enabled) {
-					for (auto hnd_it = hnds.begin() + idx, val_it = storage.begin() + idx, end = hnds.end(); hnd_it != end; ++hnd_it, ++val_it) {
+					for (auto hnd_it = hnds.begin(), val_it = storage.begin() + idx, end = hnds.end(); hnd_it != end; ++hnd_it, ++val_it) {
 						reg.template on<initialize_event>().invoke(reg, *hnd_it, *val_it);
 					}
 				}
 			} else {
 				if constexpr (initialize_event_enabled) {
-					for (auto hnd_it = hnds.begin() + idx, end = hnds.end(); hnd_it != end; ++hnd_it) {
+					for (auto hnd_it = hnds.begin(), end = hnds.end(); hnd_it != end; ++hnd_it) {
 						reg.template on<initialize_event>().invoke(reg, *hnd_it);
 					}
 				}
 			}
 		}
 
+		/** records a component to be added to the back of the pool on sync, the value is constructed immediately */
+		template<typename ... arg_Ts> requires (command_buffer_enabled && (!storage_enabled || std::is_constructible_v<value_type, arg_Ts...>))
+		constexpr void emplace_back(policy::deferred, handle_type hnd, arg_Ts&&... args) {
+			auto& buffer = reg.template get_attribute<command_buffer_type>();
+			if constexpr (storage_enabled) {
+				buffer.emplaced.emplace_back(std::piecewise_construct, std::forward_as_tuple(hnd), std::forward_as_tuple(std::forward<arg_Ts>(args)...));
+			} else {
+				buffer.emplaced.emplace_back(hnd);
+			}
+		}
+
+		/** records a component to be erased from the pool on sync */
+		constexpr void erase(policy::deferred, handle_type hnd) requires (command_buffer_enabled) {
+			auto& buffer = reg.template get_attribute<command_buffer_type>();
+			buffer.erased.emplace_back(hnd, buffer.emplaced.size());
+		}
+
+		/** records components to be erased from the pool on sync */
+		constexpr void erase(policy::deferred, std::span<handle_type> hnds) requires (command_buffer_enabled) {
+			auto& buffer = reg.template get_attribute<command_buffer_type>();
+			for (const auto& hnd : hnds) {
+				buffer.erased.emplace_back(hnd, buffer.emplaced.size());
+			}
+		}
+
+		/** applies the operations recorded with the deferred policy in the order they were recorded. an emplace followed by an erase of the same handle is cancelled, the remaining erases are applied before the emplaces, each as a single batch */
+		template<typename seq_T=sequence_policy>
+		constexpr void sync() requires (command_buffer_enabled) {
+			auto& buffer = reg.template get_attribute<command_buffer_type>();
+			seq_T policy;
+
+			// events may record further operations, they are applied by the next sync
+			auto erased = std::move(buffer.erased);
+			buffer.erased.clear();
+			auto emplaced = std::move(buffer.emplaced);
+			buffer.emplaced.clear();
+
+			auto get_handle = [](const auto& cmd) -> const handle_type& {
+				if constexpr (storage_enabled) return cmd.first; else return cmd;
+			};
+
+			// sorted by handle, the last recorded erase of each handle is kept
+			std::ranges::sort(erased, [](const auto& lhs, const auto& rhs) {
+				return handle_less(lhs.first, rhs.first) || (lhs.first == rhs.first && lhs.second > rhs.second);
+			});
+			erased.erase(std::unique(erased.begin(), erased.end(), [](const auto& lhs, const auto& rhs) { return lhs.first == rhs.first; }), erased.end());
+
+			std::size_t kept = 0;
+			for (std::size_t cmd_i = 0; cmd_i < emplaced.size(); ++cmd_i) {
+				const handle_type& hnd = get_handle(emplaced[cmd_i]);
+				auto it = std::ranges::lower_bound(erased, hnd, handle_less, [](const auto& cmd) -> const handle_type& { return cmd.first; });
+				if (it != erased.end() && it->first == hnd && cmd_i < it->second) continue; // erased after it was recorded
+
+				if (kept != cmd_i) emplaced[kept] = std::move(emplaced[cmd_i]);
+				++kept;
+			}
+			emplaced.erase(emplaced.begin() + kept, emplaced.end());
+
+			if (!erased.empty()) {
+				std::vector<handle_type> hnds;
+				hnds.reserve(erased.size());
+				for (const auto& [hnd, count] : erased) {
+					if (contains(hnd)) hnds.push_back(hnd);
+				}
+
+				erase<seq_T>(std::span<handle_type>(hnds));
+			}
+
+			if (emplaced.empty()) return;
+
+			// sorted by handle for locality in the indexer, the first recorded value is kept
+			std::stable_sort(emplaced.begin(), emplaced.end(), [&](const auto& lhs, const auto& rhs) { return handle_less(get_handle(lhs), get_handle(rhs)); });
+			emplaced.erase(std::unique(emplaced.begin(), emplaced.end(), [&](const auto& lhs, const auto& rhs) { return get_handle(lhs) == get_handle(rhs); }), emplaced.end());
+			std::erase_if(emplaced, [&](const auto& cmd) {
+				if constexpr (!std::is_void_v<entity_type>) {
+					if (!reg.template alive<entity_type>(get_handle(cmd))) return true;
+				}
+				return contains(get_handle(cmd));
+			});
+
+			if constexpr (pointer_stable || requires { typename seq_T::compare_type; } || requires { policy.enter(reg, handle_type{}); }) { // each insertion is positioned by the policy
+				for (auto& cmd : emplaced) {
+					if constexpr (storage_enabled) {
+						emplace_back<seq_T>(cmd.first, std::move(cmd.second));
+					} else {
+						emplace_back<seq_T>(cmd);
+					}
+				}
+			} else {
+				std::vector<handle_type> hnds;
+				hnds.reserve(emplaced.size());
+				for (auto& cmd : emplaced) {
+					hnds.push_back(get_handle(cmd));
+				}
+
+				append(hnds, [&](auto& storage) {
+					for (auto& cmd : emplaced) {
+						storage.emplace_back(std::move(cmd.second));
+					}
+				});
+			}
+		}
+
 		/** erases a component from the pool */
-		template<typename seq_T=policy::optimal>
+		template<typename seq_T=sequence_policy>
 		constexpr void erase(handle_type hnd) {
 			auto& indexer = reg.template get_attribute<indexer_type>();
 			seq_T policy;
@@ -315,8 +689,21 @@ namespace ecs {
 			if constexpr (manager_enabled) {
 				auto& manager = reg.template get_attribute<manager_type>();
 
+				if (!contains(hnd)) return; // absent, or a stale version of the entity index
+
+				if constexpr (requires { policy.leave(reg, hnd); }) {
+					policy.leave(reg, hnd);
+				}
+
 				std::size_t idx = index_of(hnd);
 
+				if constexpr (lazy_enabled) {
+					indexer.erase(hnd);
+					unmark(hnd);
+					bury(idx);
+					return;
+				}
+
 				if constexpr (terminate_event_enabled) {
 					if constexpr (storage_enabled) {
 						reg.template on<terminate_event>().invoke(reg, at(idx), component_at(idx)); 
@@ -326,6 +713,12 @@ namespace ecs {
 				}
 
 				indexer.erase(hnd);
+				unmark(hnd);
+
+				if constexpr (pointer_stable) {
+					vacate(idx);
+					return;
+				}
 				
 				auto update = policy.erase(manager, manager.begin() + idx);
 
@@ -333,30 +726,114 @@ namespace ecs {
 					indexer.at(*it) = std::distance(manager.begin(), it);
 				}
 				
-				if constexpr (storage_enabled) {
-					auto& storage = reg.template get_attribute<storage_type>();
-					policy.erase(storage, storage.begin() + idx);
-				}
+				for_each_column([&](auto& column) { policy.erase(column, column.begin() + idx); });
 			} else {
 				indexer.erase(hnd);
+				unmark(hnd);
 			}
 
 			
 		}
 
 		/** erases a component from the pool */
-		template<typename seq_T=policy::optimal>
+		template<typename seq_T=sequence_policy>
 		constexpr void erase(std::span<handle_type> hnds) {
-			for (auto& hnd : hnds) erase<seq_T>(hnd); // TODO: improve performance, execute rolling move from sorted handles
+			auto& indexer = reg.template get_attribute<indexer_type>();
+			seq_T policy;
+
+			if constexpr (!manager_enabled) {
+				for (auto& hnd : hnds) { indexer.erase(hnd); unmark(hnd); }
+			} else if constexpr (pointer_stable || lazy_enabled || requires { policy.leave(reg, hnds[0]); }) { // erased in place or leaving the group reorders the pool
+				for (auto& hnd : hnds) erase<seq_T>(hnd);
+			} else {
+				auto& manager = reg.template get_attribute<manager_type>();
+				
+				std::vector<std::size_t> indices;
+				indices.reserve(hnds.size());
+				for (auto& hnd : hnds) {
+					if (std::size_t idx = index_of(hnd); idx != static_cast<std::size_t>(-1)) {
+						indices.push_back(idx);
+					}
+				}
+				
+				std::sort(indices.begin(), indices.end());
+				indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+				erase_indices<seq_T>(indices);
+			}
+		}
+
+		/** erases the components the predicate holds for, called with the handle and component, or either alone. the pool is scanned in order and compacted in a single pass, returns the number of erased components */
+		template<typename seq_T=sequence_policy, typename pred_T>
+		constexpr std::size_t erase_if(pred_T&& pred) requires (manager_enabled) {
+			auto& manager = reg.template get_attribute<manager_type>();
+			seq_T policy;
+
+			std::vector<std::size_t> indices;
+			auto scan = [&](auto& ... storage) {
+				for (std::size_t idx = 0, n = manager.size(); idx < n; ++idx) {
+					if constexpr (pointer_stable || lazy_enabled) {
+						if (manager[idx] == tombstone{}) continue;
+					}
+
+					bool match;
+					if constexpr (std::is_invocable_v<pred_T&, const handle_type&, decltype(storage[idx])...>) {
+						match = std::invoke(pred, manager[idx], storage[idx]...);
+					} else if constexpr (sizeof...(storage) != 0 && std::is_invocable_v<pred_T&, decltype(storage[idx])...>) {
+						match = std::invoke(pred, storage[idx]...);
+					} else {
+						match = std::invoke(pred, manager[idx]);
+					}
+					if (match) indices.push_back(idx);
+				}
+			};
+
+			if constexpr (storage_enabled) {
+				scan(reg.template get_attribute<storage_type>());
+			} else {
+				scan();
+			}
+
+			if (indices.empty()) return 0;
+
+			if constexpr (pointer_stable || lazy_enabled || requires { policy.leave(reg, manager[0]); }) { // erased in place or leaving the group reorders the pool
+				std::vector<handle_type> hnds;
+				hnds.reserve(indices.size());
+				for (std::size_t idx : indices) hnds.push_back(manager[idx]);
+				for (auto& hnd : hnds) erase<seq_T>(hnd);
+			} else {
+				erase_indices<seq_T>(indices);
+			}
+
+			return indices.size();
 		}
 
 		/** erases a component at an index */
-		template<typename seq_T=policy::optimal>
+		template<typename seq_T=sequence_policy>
 		constexpr void erase_at(std::size_t idx) requires (manager_enabled) {
 			auto& indexer = reg.template get_attribute<indexer_type>();
 			auto& manager = reg.template get_attribute<manager_type>();
 			seq_T policy;
 
+			if constexpr (pointer_stable) {
+				if (at(idx) == tombstone{}) return; // already vacated, its slot is on the free list
+			}
+
+			if constexpr (lazy_enabled) {
+				if (at(idx) == tombstone{}) return; // already buried
+
+				indexer.erase(at(idx));
+				unmark(at(idx));
+				bury(idx);
+				return;
+			}
+
+			if constexpr (requires { policy.leave(reg, at(idx)); }) { // leaves the group before the terminate event, as erase does
+				handle_type hnd = at(idx);
+				policy.leave(reg, hnd);
+				idx = index_of(hnd);
+			}
+
 			if constexpr (terminate_event_enabled) {
 				if constexpr (storage_enabled) {
 					reg.template on<terminate_event>().invoke(reg, at(idx), component_at(idx)); 
@@ -364,10 +841,18 @@ namespace ecs {
 					reg.template on<terminate_event>().invoke(reg, at(idx)); 
 				}
 			}
+
+			if constexpr (pointer_stable) {
+				indexer.erase(at(idx));
+				unmark(at(idx));
+				vacate(idx);
+				return;
+			}
 			
 			auto pos = manager.begin() + idx;
 
 			indexer.erase(*pos);
+			unmark(*pos);
 						
 			auto update = policy.erase(manager, pos);
 
@@ -375,19 +860,29 @@ namespace ecs {
 				indexer.at(*it) = std::distance(manager.begin(), it);
 			}
 			
-			if constexpr (storage_enabled) {
-				auto& storage = reg.template get_attribute<storage_type>();
-				policy.erase(storage, storage.begin() + idx);
-			}
+			for_each_column([&](auto& column) { policy.erase(column, column.begin() + idx); });
 		}
 
 		/** erases a component at an index */
-		template<typename seq_T=policy::optimal>
+		template<typename seq_T=sequence_policy>
 		constexpr void erase_at(std::size_t idx, std::size_t count) requires (manager_enabled) {
 			auto& indexer = reg.template get_attribute<indexer_type>();
 			auto& manager = reg.template get_attribute<manager_type>();
 			seq_T policy;
 
+			if constexpr (pointer_stable || lazy_enabled) {
+				for (std::size_t i = idx, n = idx + count; i < n; ++i) {
+					if (!(at(i) == tombstone{})) erase_at<seq_T>(i);
+				}
+				return;
+			}
+
+			if constexpr (requires { policy.leave(reg, at(idx)); }) { // leaving the group reorders the range
+				std::vector<handle_type> hnds(manager.begin() + idx, manager.begin() + idx + count);
+				for (auto& hnd : hnds) erase<seq_T>(hnd);
+				return;
+			}
+
 			if constexpr (terminate_event_enabled) {
 				if constexpr (storage_enabled) {
 					for (std::size_t i = idx, n = idx + count; i < n; ++i) {
@@ -404,6 +899,7 @@ namespace ecs {
 
 			for (auto it = pos, end = pos + count; it < end; ++it) {
 				indexer.erase(*it);
+				unmark(*it);
 			}
 			
 			auto update = policy.erase_n(manager, pos, count);
@@ -412,41 +908,363 @@ namespace ecs {
 				indexer.at(*it) = std::distance(manager.begin(), it);
 			}
 			
-			if constexpr (storage_enabled) {
-				auto& storage = reg.template get_attribute<storage_type>();
-				policy.erase_n(storage, storage.begin() + idx, count);
+			for_each_column([&](auto& column) { policy.erase_n(column, column.begin() + idx, count); });
+		}
+
+		/** swaps the positions of two component-entity pairs within the pool */
+		constexpr void swap_at(std::size_t lhs, std::size_t rhs) requires (manager_enabled) {
+			if (lhs == rhs) return;
+
+			auto& indexer = reg.template get_attribute<indexer_type>();
+			auto& manager = reg.template get_attribute<manager_type>();
+
+			std::swap(manager[lhs], manager[rhs]);
+			indexer.at(manager[lhs]) = lhs;
+			indexer.at(manager[rhs]) = rhs;
+
+			for_each_column([&](auto& column) { std::ranges::iter_swap(column.begin() + lhs, column.begin() + rhs); });
+		}
+
+		/** reorders the pool so the entities shared with the pool of U are at the front in the order of U, returns the number of shared entities */
+		template<traits::component_class U> requires (manager_enabled && !pointer_stable && !lazy_enabled && !requires { typename sequence_policy::compare_type; } && !requires { typename sequence_policy::group_type; })
+		constexpr std::size_t sort_as() {
+			static_assert(std::is_same_v<handle_type, traits::component::get_handle_t<std::remove_const_t<U>>>, "sort_as requires both components to share a handle type.");
+
+			auto other = reg.template pool<const std::remove_const_t<U>>();
+			std::size_t n = size();
+
+			std::vector<std::size_t> order; // order[new index] = old index
+			order.reserve(n);
+			std::vector<bool> shared(n);
+			
+			for (std::size_t i = 0; i < other.size(); ++i) {
+				if (std::size_t idx = index_of(other.at(i)); idx != static_cast<std::size_t>(-1) && at(idx) == other.at(i)) { // a stale version left at the entity index is not shared
+					order.push_back(idx);
+					shared[idx] = true;
+				}
+			}
+
+			std::size_t count = order.size();
+			for (std::size_t idx = 0; idx < n; ++idx) {
+				if (!shared[idx]) order.push_back(idx);
+			}
+
+			auto& manager = reg.template get_attribute<manager_type>();
+			permute(manager, order);
+			for_each_column([&](auto& column) { permute(column, order); });
+
+			auto& indexer = reg.template get_attribute<indexer_type>();
+			for (std::size_t idx = 0; idx < n; ++idx) {
+				indexer.at(manager[idx]) = idx;
+			}
+
+			reg.template get_attribute<alignment_type>() = count;
+			return count;
+		}
+
+		/** restores the order of a sorted pool after its components were changed in place through modify. the order is stable for equal components, the indexer is only rewritten for the handles that moved */
+		constexpr void sort() requires (sorted_enabled && manager_enabled && storage_enabled) {
+			auto& storage = reg.template get_attribute<storage_type>();
+			typename sequence_policy::compare_type cmp;
+
+			auto less = [&](std::size_t lhs, std::size_t rhs) { return cmp(storage[lhs], storage[rhs]); };
+			std::size_t n = size();
+
+			std::vector<std::size_t> order(n); // order[new index] = old index
+			std::iota(order.begin(), order.end(), std::size_t{ 0 });
+			if (std::ranges::is_sorted(order, less)) return;
+			std::ranges::stable_sort(order, less);
+
+			auto& manager = reg.template get_attribute<manager_type>();
+			permute(manager, order);
+			for_each_column([&](auto& column) { permute(column, order); });
+
+			auto& indexer = reg.template get_attribute<indexer_type>();
+			for (std::size_t idx = 0; idx < n; ++idx) {
+				if (order[idx] != idx) indexer.at(manager[idx]) = idx;
 			}
 		}
 
 		/** removes all components from the pool */
-		template<typename seq_T=policy::optimal>
+		template<typename seq_T=sequence_policy>
 		constexpr void clear() {
+			seq_T policy;
+
+			if constexpr (lazy_enabled) {
+				compact(); // calls the pending terminate events
+			}
+
 			if constexpr (terminate_event_enabled) {
 				auto invoker = reg.template on<terminate_event>();
-				for (std::size_t pos = 0; pos < size(); ++pos) {
+				if (!invoker.empty()) { // no listeners, skip the dispatch pass
+					auto& manager = reg.template get_attribute<manager_type>();
+					auto dispatch = [&](auto& ... storage) {
+						for (std::size_t pos = 0; pos < manager.size(); ++pos) { // listeners may still emplace into the pool
+							if constexpr (pointer_stable) {
+								if (manager[pos] == tombstone{}) continue;
+							}
+							invoker.invoke(reg, manager[pos], storage[pos]...);
+						}
+					};
+
 					if constexpr (storage_enabled) {
-						invoker.invoke(reg, at(pos), component_at(pos));
+						dispatch(reg.template get_attribute<storage_type>());
 					} else {
-						invoker.invoke(reg, at(pos));
+						dispatch();
 					}
 				}
 			}
 
-			if constexpr (storage_enabled) {
-				reg.template get_attribute<storage_type>().clear();
-			}
+			for_each_column([&](auto& column) { column.clear(); });
 
 			if constexpr (manager_enabled) {
 				reg.template get_attribute<manager_type>().clear();
 			}
 
-			{ // indexer type
-				std::size_t sz = reg.template get_attribute<indexer_type>().size();
-				reg.template get_attribute<indexer_type>().clear();
+			reg.template get_attribute<indexer_type>().clear();
+
+			if constexpr (presence_enabled) {
+				reg.template get_attribute<presence_type>().clear();
+			}
+
+			if constexpr (pointer_stable) {
+				reg.template get_attribute<free_list_type>().clear();
+			}
+
+			if constexpr (manager_enabled) {
+				reg.template get_attribute<alignment_type>() = 0;
+			}
+
+			if constexpr (requires { policy.clear(reg); }) {
+				policy.clear(reg);
 			}
 		}
 		
+		/** calls the terminate events deferred by the lazy policy and erases the tombstones in a single compacting pass */
+		constexpr void compact() requires (lazy_enabled) {
+			auto& graveyard = reg.template get_attribute<graveyard_type>();
+			if (graveyard.empty()) return;
+
+			auto& indexer = reg.template get_attribute<indexer_type>();
+			auto& manager = reg.template get_attribute<manager_type>();
+			policy::lazy policy;
+
+			// events may erase further components, their tombstones are compacted in the same pass
+			std::vector<std::size_t> indices;
+			while (!graveyard.empty()) {
+				auto dead = std::move(graveyard);
+				graveyard.clear();
+
+				for (auto& [idx, hnd] : dead) {
+					if constexpr (terminate_event_enabled) {
+						if constexpr (storage_enabled) {
+							reg.template on<terminate_event>().invoke(reg, hnd, component_at(idx));
+						} else {
+							reg.template on<terminate_event>().invoke(reg, hnd);
+						}
+					}
+					indices.push_back(idx);
+				}
+			}
+
+			std::sort(indices.begin(), indices.end());
+			indices.erase(std::unique(indices.begin(), indices.end()), indices.end()); // erase_sorted requires unique indices
+
+			for_each_column([&](auto& column) { policy.erase_sorted(column, indices); });
+
+			for (std::size_t idx : policy.erase_sorted(manager, indices)) {
+				indexer.at(manager[idx]) = idx;
+			}
+		}
+
 	private:
+		/** erases the components at the sorted unique indices, terminate events are called first and the indexer is patched for the moved handles only */
+		template<typename seq_T>
+		constexpr void erase_indices(std::span<const std::size_t> indices) requires (manager_enabled) {
+			if (indices.empty()) return;
+
+			auto& indexer = reg.template get_attribute<indexer_type>();
+			auto& manager = reg.template get_attribute<manager_type>();
+			seq_T policy;
+
+			if constexpr (terminate_event_enabled) {
+				auto invoker = reg.template on<terminate_event>();
+				if (!invoker.empty()) {
+					for (std::size_t idx : indices) {
+						if constexpr (storage_enabled) {
+							invoker.invoke(reg, at(idx), component_at(idx));
+						} else {
+							invoker.invoke(reg, at(idx));
+						}
+					}
+				}
+			}
+
+			for (std::size_t idx : indices) {
+				indexer.erase(manager[idx]);
+				unmark(manager[idx]);
+			}
+
+			for_each_column([&](auto& column) { policy.erase_sorted(column, indices); });
+
+			for (std::size_t idx : policy.erase_sorted(manager, indices)) {
+				indexer.at(manager[idx]) = idx;
+			}
+		}
+
+		/** applies the function to each column stored parallel to the manager */
+		constexpr void for_each_column(auto&& fn) const {
+			if constexpr (storage_enabled) {
+				fn(reg.template get_attribute<storage_type>());
+			}
+
+			if constexpr (tracker_enabled) {
+				fn(reg.template get_attribute<tracker_type>().column);
+			}
+		}
+
+		/** appends the handles to the back of the pool, fill appends a value to the storage for each handle. initialize events are called once every handle is appended */
+		constexpr void append(std::span<const handle_type> hnds, auto&& fill) requires (manager_enabled) {
+			auto& manager = reg.template get_attribute<manager_type>();
+			auto& indexer = reg.template get_attribute<indexer_type>();
+			if constexpr (version_checked) {
+				for (const auto& hnd : hnds) evict(hnd);
+			}
+			std::size_t first = manager.size();
+
+			check_capacity(hnds.size());
+			reserve(first + hnds.size());
+
+			manager.append_range(hnds);
+			for (std::size_t i = 0; i < hnds.size(); ++i) {
+				indexer.emplace(hnds[i], first + i);
+				mark(hnds[i]);
+			}
+
+			if constexpr (tracker_enabled) {
+				auto& tracker = reg.template get_attribute<tracker_type>();
+				tracker.column.resize(manager.size(), change_ticks{ tracker.tick, tracker.tick });
+			}
+
+			if constexpr (storage_enabled) {
+				auto& storage = reg.template get_attribute<storage_type>();
+				fill(storage);
+				assert(storage.size() == manager.size());
+			}
+
+			if constexpr (initialize_event_enabled) {
+				auto invoker = reg.template on<initialize_event>();
+				for (std::size_t idx = first; idx < manager.size(); ++idx) {
+					if constexpr (storage_enabled) {
+						invoker.invoke(reg, at(idx), component_at(idx));
+					} else {
+						invoker.invoke(reg, at(idx));
+					}
+				}
+			}
+		}
+
+		/** erases the component left at the entity index by a destroyed version of the handle, the versioned indexer never overwrites another version. its terminate event is called before the insertion */
+		constexpr void evict(const handle_type& hnd) requires (manager_enabled && version_checked) {
+			const auto& indexer = reg.template get_attribute<const indexer_type>();
+			if (const handle_type* stale = indexer.occupant(std::size_t(hnd)); stale != nullptr && !(*stale == hnd)) {
+				erase(handle_type(*stale));
+			}
+		}
+
+		/** sets the presence bit of the entity index of the handle */
+		constexpr void mark(const handle_type& hnd) const {
+			if constexpr (presence_enabled) {
+				reg.template get_attribute<presence_type>().set(std::size_t(hnd));
+			}
+		}
+
+		/** clears the presence bit of the entity index of the handle */
+		constexpr void unmark(const handle_type& hnd) const {
+			if constexpr (presence_enabled) {
+				reg.template get_attribute<presence_type>().reset(std::size_t(hnd));
+			}
+		}
+
+		/** throws if n more components would exceed the indices addressable by index_type */
+		constexpr void check_capacity(std::size_t n) const requires (manager_enabled) {
+			if (n > max_size() - size()) {
+				throw std::length_error("pool size exceeds the index_type of the indexer");
+			}
+		}
+
+		/** leaves a tombstone at the index and pushes the index to the free list */
+		constexpr void vacate(std::size_t idx) requires (pointer_stable) {
+			auto& manager = reg.template get_attribute<manager_type>();
+			manager[idx] = tombstone{};
+
+			if constexpr (storage_enabled) {
+				auto& storage = reg.template get_attribute<storage_type>();
+				storage[idx] = value_type{}; // releases the resources held by the erased value
+			}
+
+			reg.template get_attribute<free_list_type>().push_back(idx);
+		}
+
+		/** leaves a tombstone at the index and records it in the graveyard to be compacted */
+		constexpr void bury(std::size_t idx) requires (lazy_enabled) {
+			auto& manager = reg.template get_attribute<manager_type>();
+			reg.template get_attribute<graveyard_type>().emplace_back(idx, manager[idx]);
+			manager[idx] = tombstone{};
+		}
+
+		/** orders handles by index for locality in the indexer, versions of the same index are ordered apart so equal handles are adjacent */
+		static constexpr bool handle_less(const handle_type& lhs, const handle_type& rhs) {
+			if (std::size_t(lhs) != std::size_t(rhs)) return std::size_t(lhs) < std::size_t(rhs);
+			return std::less<handle_type>{ }(lhs, rhs);
+		}
+
+		/** moves the element at order[i] to i, following each cycle of the permutation with swaps */
+		static constexpr void permute(auto& range, const std::vector<std::size_t>& order) {
+			std::vector<bool> placed(order.size());
+			for (std::size_t i = 0; i < order.size(); ++i) {
+				if (placed[i]) continue;
+				
+				for (std::size_t j = i; ; j = order[j]) {
+					placed[j] = true;
+					if (order[j] == i) break;
+					std::ranges::iter_swap(range.begin() + j, range.begin() + order[j]);
+				}
+			}
+		}
+
+		/** moves the component-entity pair at the index to its sorted position after its component was changed in place */
+		constexpr void reposition(std::size_t idx) requires (sorted_enabled && manager_enabled && storage_enabled) {
+			auto& storage = reg.template get_attribute<storage_type>();
+			typename sequence_policy::compare_type cmp;
+
+			for (; idx > 0 && cmp(storage[idx], storage[idx - 1]); --idx) {
+				swap_at(idx - 1, idx);
+			}
+			for (; idx + 1 < size() && cmp(storage[idx + 1], storage[idx]); ++idx) {
+				swap_at(idx, idx + 1);
+			}
+		}
+
+		/** moves the component-entity pair at the back of the pool to the position found by the policy */
+		template<typename seq_T>
+		constexpr void sort_back(seq_T& policy) requires (storage_enabled) {
+			auto& indexer = reg.template get_attribute<indexer_type>();
+			auto& manager = reg.template get_attribute<manager_type>();
+			auto& storage = reg.template get_attribute<storage_type>();
+
+			auto pos = policy.find_position(storage, storage.end() - 1);
+			std::size_t idx = std::distance(storage.begin(), pos);
+			
+			for_each_column([&](auto& column) { policy.rotate_back(column, column.begin() + idx); });
+			auto update = policy.rotate_back(manager, manager.begin() + idx);
+
+			indexer.at(manager[idx]) = idx;
+			for (auto it = update.begin(), end = update.end(); it < end; ++it) {
+				indexer.at(*it) = std::distance(manager.begin(), it);
+			}
+		}
+
 		reg_T& reg;
 	};
 	
@@ -8,6 +8,11 @@
 
 #include <memory>
 #include <type_traits>
+#include <span>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <optional>
 
 namespace ecs {
 	template<typename reg_T>
@@ -20,6 +25,8 @@ namespace ecs {
 		
 		virtual void release(reg_T& reg) = 0;
 		virtual void release(const reg_T& reg) const = 0;
+
+		virtual void shrink(reg_T& reg) = 0;
 	};
 	
 	template<traits::attribute_class T, typename reg_T>
@@ -60,6 +67,15 @@ namespace ecs {
 			std::destroy_at(&value);
 		}
 
+		void shrink(reg_T& reg) override {
+			if constexpr (requires { T::shrink(reg, value); }) {
+				T::shrink(reg, value);
+			}
+			else if constexpr (requires { value.shrink_to_fit(); }) {
+				value.shrink_to_fit();
+			}
+		}
+
 		void acquire(reg_T& reg, priority p) override { 
 			if constexpr (requires { mutex.lock(p); }) {
 				mutex.lock(p); 
@@ -301,6 +317,19 @@ namespace ecs {
 			});
 		}
 
+		/* releases the unused capacity of every attribute. */
+		void shrink_all() {
+			util::apply<static_dependencies>([&]<typename ... attrib_Ts>() { 
+				(get_cache<attrib_Ts>().shrink(*this), ...);
+			});
+
+			#if ECS_DYNAMIC_REGISTRY
+			for (auto& [id, cache] : dynamic_set) { 
+				cache->shrink(*this);
+			}
+			#endif
+		}
+
 		/* initializes an invoker service class for the event T. */
 		template<traits::event_class T>
 		invoker_t<T> on() {
@@ -370,17 +399,119 @@ namespace ecs {
 		}
 
 		/* constructs and associates a component of type T to the entity ent, if not already present else returns original. */
-		template<traits::component_class T, typename seq_T=policy::optimal, typename ... arg_Ts>
+		template<traits::component_class T, typename seq_T=traits::component::get_sequence_policy_t<bind_t<T>>, typename ... arg_Ts>
 		decltype(auto) emplace_at(std::size_t idx, get_component_handle_t<T> ent, arg_Ts&& ... args) {
 			return pool<T>().template emplace_at<seq_T>(idx, ent, std::forward<arg_Ts>(args)...);
 		}
 
 		/* destroys the component of type T associated to the entity ent. */
-		template<traits::component_class comp_T, typename seq_T=policy::optimal>
+		template<traits::component_class comp_T, typename seq_T=traits::component::get_sequence_policy_t<bind_t<comp_T>>>
 		void erase(get_component_handle_t<comp_T> ent) {
 			pool<comp_T>().template erase<seq_T>(ent);
 		}
 
+		/* destroys the components of type T the predicate holds for, returns the number destroyed. */
+		template<traits::component_class T, typename seq_T=traits::component::get_sequence_policy_t<bind_t<T>>, typename pred_T>
+		std::size_t erase_if(pred_T&& pred) {
+			return pool<T>().template erase_if<seq_T>(std::forward<pred_T>(pred));
+		}
+
+		/* moves the entities ents from component A to component B with one bulk erase and one bulk append. B is converted from the value of A when
+		   no args are given and the value converts, otherwise constructed from args. entities without A or already with B are skipped, returns the number moved. */
+		template<traits::component_class A, traits::component_class B, typename ... arg_Ts>
+		std::size_t transition(std::span<const get_component_handle_t<A>> ents, arg_Ts&& ... args) {
+			static_assert(std::is_same_v<get_component_handle_t<A>, get_component_handle_t<B>>, "transition requires components sharing a handle type.");
+			using handle_type = get_component_handle_t<A>;
+			using from_value_type = traits::component::get_value_t<bind_t<A>>;
+			using to_value_type = traits::component::get_value_t<bind_t<B>>;
+			using from_terminate_event = traits::component::get_terminate_event_t<bind_t<A>>;
+
+			auto from = pool<A>();
+			auto to = pool<B>();
+
+			std::vector<handle_type> hnds;
+			hnds.reserve(ents.size());
+			for (const auto& ent : ents) {
+				if (from.contains(ent) && !to.contains(ent)) hnds.push_back(ent);
+			}
+			// ordered by index, a contained handle is the only version of its index so duplicates are adjacent
+			std::sort(hnds.begin(), hnds.end(), [](const handle_type& lhs, const handle_type& rhs) { return std::size_t(lhs) < std::size_t(rhs); });
+			hnds.erase(std::unique(hnds.begin(), hnds.end(), [](const handle_type& lhs, const handle_type& rhs) { return lhs == rhs; }), hnds.end());
+
+			if (hnds.empty()) return 0;
+
+			constexpr bool storage_enabled = !std::is_void_v<traits::component::get_storage_t<bind_t<A>>> && !std::is_void_v<traits::component::get_storage_t<bind_t<B>>>;
+			if constexpr (sizeof...(arg_Ts) == 0 && storage_enabled && requires { to_value_type(std::move(from.get_component(hnds[0]))); }) {
+				// values are copied instead of moved while the terminate event of A observes them
+				bool observed = false;
+				if constexpr (!std::is_void_v<from_terminate_event>) {
+					observed = !on<from_terminate_event>().empty();
+				}
+
+				std::vector<to_value_type> values;
+				values.reserve(hnds.size());
+				for (const auto& hnd : hnds) {
+					if constexpr (requires { to_value_type(std::as_const(from.get_component(hnd))); }) {
+						if (observed) {
+							values.emplace_back(std::as_const(from.get_component(hnd)));
+							continue;
+						}
+					}
+					values.emplace_back(std::move(from.get_component(hnd)));
+				}
+
+				from.erase(hnds);
+				to.emplace_back(hnds, std::move(values));
+			} else {
+				from.erase(hnds);
+				to.emplace_back(hnds, std::forward<arg_Ts>(args)...);
+			}
+
+			return hnds.size();
+		}
+
+		/* adds the components of type T for the entities ents by adopting pages of values built outside the registry without copying. */
+		template<traits::component_class T, typename seq_T=traits::component::get_sequence_policy_t<bind_t<T>>>
+		void adopt(std::span<const get_component_handle_t<T>> ents, const auto& pages) {
+			pool<T>().template adopt<seq_T>(ents, pages);
+		}
+
+		/* records the component of type T to be constructed for the entity ent on sync. */
+		template<traits::component_class T, typename ... arg_Ts>
+		void emplace(policy::deferred, get_component_handle_t<T> ent, arg_Ts&& ... args) {
+			pool<T>().emplace_back(policy::deferred{}, ent, std::forward<arg_Ts>(args)...);
+		}
+
+		/* records the component of type T associated to the entity ent to be destroyed on sync. */
+		template<traits::component_class T>
+		void erase(policy::deferred, get_component_handle_t<T> ent) {
+			pool<T>().erase(policy::deferred{}, ent);
+		}
+
+		/* applies the deferred operations recorded for the components Ts. */
+		template<traits::component_class ... Ts>
+		void sync() {
+			(pool<Ts>().sync(), ...);
+		}
+
+		/* compacts the tombstones left by the lazy policy for the components Ts. */
+		template<traits::component_class ... Ts>
+		void compact() {
+			(pool<Ts>().compact(), ...);
+		}
+
+		/* reorders the pool of T to the order of the entities shared with the pool of U. */
+		template<traits::component_class T, traits::component_class U>
+		std::size_t sort_as() {
+			return pool<T>().template sort_as<bind_t<U>>();
+		}
+
+		/* restores the order of the sorted pool of T after its components were changed in place. */
+		template<traits::component_class T>
+		void sort() {
+			pool<T>().sort();
+		}
+
 		/* returns the number of components of type T. */
 		template<traits::component_class T>
 		std::size_t count() const {
@@ -411,6 +542,60 @@ namespace ecs {
 			return pool<T>().get(ent);
 		}
 
+		/* returns the component of type T associated with the entity ent and marks it changed. */
+		template<traits::component_class T>
+		decltype(auto) modify(get_component_handle_t<T> ent) {
+			return pool<T>().modify(ent);
+		}
+
+		/* applies fn to the component of type T associated to the entity ent in place and calls its update event. */
+		template<traits::component_class T, typename fn_T>
+		void patch(get_component_handle_t<T> ent, fn_T&& fn) {
+			pool<T>().patch(ent, std::forward<fn_T>(fn));
+		}
+
+		/* applies fn to the components of type T associated to the entities in place and calls a single update event. */
+		template<traits::component_class T, typename fn_T>
+		void patch(std::span<const get_component_handle_t<T>> ents, fn_T&& fn) {
+			pool<T>().patch(ents, std::forward<fn_T>(fn));
+		}
+
+		/* starts a new tick for the change tracking components Ts. */
+		template<traits::component_class ... Ts>
+		void advance_tick() {
+			(pool<Ts>().advance_tick(), ...);
+		}
+
+		/* returns the handle of the asset T loaded with the key, constructing the asset from args on first load. the handle gains a reference. */
+		template<traits::component_class T, typename ... arg_Ts> requires (traits::is_asset_v<traits::get_trait_category_t<bind_t<T>, ECS_DEFAULT_TAG>>)
+		get_component_handle_t<T> load(const traits::component::get_key_t<bind_t<T>>& key, arg_Ts&& ... args) {
+			auto [hnd, loaded] = get_attribute<traits::component::get_library_t<bind_t<T>>>().acquire(key);
+			if (loaded) {
+				pool<T>().emplace_back(hnd, std::forward<arg_Ts>(args)...);
+			}
+			return hnd;
+		}
+
+		/* adds a reference to the asset T. */
+		template<traits::component_class T> requires (traits::is_asset_v<traits::get_trait_category_t<bind_t<T>, ECS_DEFAULT_TAG>>)
+		void retain(get_component_handle_t<T> hnd) {
+			get_attribute<traits::component::get_library_t<bind_t<T>>>().retain(hnd);
+		}
+
+		/* removes a reference to the asset T, the asset is erased when the last reference is released. */
+		template<traits::component_class T> requires (traits::is_asset_v<traits::get_trait_category_t<bind_t<T>, ECS_DEFAULT_TAG>>)
+		void release(get_component_handle_t<T> hnd) {
+			if (get_attribute<traits::component::get_library_t<bind_t<T>>>().release(hnd)) {
+				pool<T>().erase(hnd);
+			}
+		}
+
+		/* returns the handle of the asset T loaded with the key, or nullopt if not loaded. */
+		template<traits::component_class T> requires (traits::is_asset_v<traits::get_trait_category_t<bind_t<T>, ECS_DEFAULT_TAG>>)
+		std::optional<get_component_handle_t<T>> find(const traits::component::get_key_t<bind_t<T>>& key) const {
+			return get_attribute<const traits::component::get_library_t<bind_t<T>>>().find(key);
+		}
+
 		/* creates a new entity of type T. */
 		template<traits::entity_class T=ECS_DEFAULT_ENTITY, typename ... arg_Ts>
 		get_entity_handle_t<T> create(arg_Ts&& ... args) {
@@ -1,22 +1,104 @@
 #pragma once
 #include "core/traits.h"
+#include "content/policy.h"
+#include "containers/bitmap.h"
 #include <functional>
+#include <variant>
 #include <util.h>
 
+namespace ecs::traits {
+	/* true if the pool of the component T maintains a presence bitmap. */
+	template<typename T> struct has_presence : std::bool_constant<component::get_presence_bitmap_v<T>> { };
+
+	/* true if the presence bit of T is exact. bits are keyed by the entity index, a versioned handle may find the bit of a stale version left in the pool. */
+	template<typename T> struct has_exact_presence : std::bool_constant<has_presence<T>::value && std::unsigned_integral<component::get_handle_t<T>>> { };
+}
+
 namespace ecs {
 	template<ecs::traits::component_class ... Ts>
 	struct inc {
 		bool operator()(const auto& it) {
-			return (it->reg.template has_component<Ts>(it.ent) && ...);
+			return ([&]<typename T>() {
+				if constexpr (traits::has_exact_presence<T>::value) {
+					return true; // tested by mask, see view_iterator::valid
+				} else {
+					return it.reg->template has_component<T>(it.get_handle()); // a set bit may belong to a stale version
+				}
+			}.template operator()<Ts>() && ...);
+		}
+
+		/* clears the bits of the entities missing a component with a presence bitmap, a clear bit is absent for every version. */
+		static void mask(const auto& reg, std::size_t word_i, bitmap::word_type& word) requires (traits::has_presence<Ts>::value || ...) {
+			([&]<typename T>() {
+				if constexpr (traits::has_presence<T>::value) {
+					word &= reg.template pool<T>().presence().word(word_i);
+				}
+			}.template operator()<Ts>(), ...);
 		}
 	};
 
 	template<traits::component_class ... Ts>
 	struct exc {
 		bool operator()(const auto& it) {
-			return !(it->reg.template has_component<Ts>(it.ent) || ...);
+			return !([&]<typename T>() {
+				if constexpr (traits::has_exact_presence<T>::value) {
+					return false; // tested by mask, see view_iterator::valid
+				} else if constexpr (traits::has_presence<T>::value) {
+					auto pool = it.reg->template pool<T>();
+					return pool.present(it.get_handle()) && pool.contains(it.get_handle()); // a set bit may belong to a stale version
+				} else {
+					return it.reg->template has_component<T>(it.get_handle());
+				}
+			}.template operator()<Ts>() || ...);
+		}
+
+		/* clears the bits of the entities holding a component with an exact presence bitmap. */
+		static void mask(const auto& reg, std::size_t word_i, bitmap::word_type& word) requires (traits::has_exact_presence<Ts>::value || ...) {
+			([&]<typename T>() {
+				if constexpr (traits::has_exact_presence<T>::value) {
+					word &= ~reg.template pool<T>().presence().word(word_i);
+				}
+			}.template operator()<Ts>(), ...);
+		}
+	};
+
+	template<traits::component_class ... Ts>
+	struct added {
+		bool operator()(const auto& it) {
+			return ([&]<typename T>() {
+				std::size_t idx = it.template index_of<T>();
+				return idx != static_cast<std::size_t>(-1) && it.reg->template pool<T>().added_at(idx);
+			}.template operator()<Ts>() && ...);
 		}
 	};
+
+	template<traits::component_class ... Ts>
+	struct changed {
+		bool operator()(const auto& it) {
+			return ([&]<typename T>() {
+				std::size_t idx = it.template index_of<T>();
+				return idx != static_cast<std::size_t>(-1) && it.reg->template pool<T>().changed_at(idx);
+			}.template operator()<Ts>() && ...);
+		}
+	};
+
+	template<traits::component_class T, typename ... alt_Ts>
+	struct holds {
+		bool operator()(const auto& it) {
+			std::size_t idx = it.template index_of<T>();
+			if (idx == static_cast<std::size_t>(-1)) return false;
+			
+			const auto& value = it.reg->template pool<T>().component_at(idx);
+			return (std::holds_alternative<alt_Ts>(value) || ...);
+		}
+	};
+}
+
+namespace ecs::traits {
+	/* true if the filter T tests presence bitmaps with mask before the remaining filters. */
+	template<typename T> struct is_presence_masked : std::false_type { };
+	template<typename ... Ts> struct is_presence_masked<inc<Ts...>> : std::disjunction<has_presence<Ts>...> { };
+	template<typename ... Ts> struct is_presence_masked<exc<Ts...>> : std::disjunction<has_exact_presence<Ts>...> { };
 }
 
 namespace ecs {
@@ -24,6 +106,9 @@ namespace ecs {
 	class view_iterator {
 		template<traits::component_class...> friend struct inc;
 		template<traits::component_class...> friend struct exc;
+		template<traits::component_class...> friend struct added;
+		template<traits::component_class...> friend struct changed;
+		template<traits::component_class, typename...> friend struct holds;
 		template<traits::component_class, typename> friend class pool;
 
 	private:
@@ -35,6 +120,7 @@ namespace ecs {
 		using entity_type = traits::component::get_entity_t<from_type>;
 		using handle_type = traits::component::get_handle_t<from_type>;
 		using manager_type = traits::component::get_manager_t<from_type>;
+		using sequence_policy = traits::component::get_sequence_policy_t<from_type>;
 		
 		using retrieve_set = util::filter_t<select_type, traits::is_component>;
 		using non_parallel_set = util::eval_t<retrieve_set, util::filter_<util::pred::disj_<ecs::traits::is_entity, util::cmp::to_<manager_type, util::cmp::is_ignore_const_same, ecs::traits::component::get_manager>::template type>::template inv>::template type>;
@@ -45,6 +131,15 @@ namespace ecs {
 	
 		static constexpr bool entity_access = util::pred::anyof_v<select_type, traits::is_entity>;
 		static constexpr bool random_access = std::tuple_size_v<non_parallel_set>;
+
+		// the presence bitmaps of the selected and filtered components reject entities before the indexer is touched
+		static constexpr bool presence_filtered = util::pred::anyof_v<non_parallel_set, traits::has_presence> || util::pred::anyof_v<util::rewrap_t<where_T, std::tuple>, traits::is_presence_masked>;
+
+		// the combined presence word of the last entity tested, entities visited in index order reuse it across increments
+		struct presence_cache {
+			std::size_t word_i = static_cast<std::size_t>(-1);
+			bitmap::word_type word = 0;
+		};
 		
 		
 	public:	
@@ -52,16 +147,16 @@ namespace ecs {
 		using difference_type = std::ptrdiff_t;
 		using sentinel_type = view_sentinel;
 		
-		using value_type = util::eval_each_t<select_type, util::eval_if_<traits::is_entity, util::supersede_<handle_type>::template type, util::eval_<util::propagate_const_<traits::component::get_value>::template type, std::add_lvalue_reference>::template type>::template type>;
+		using value_type = util::eval_each_t<select_type, util::eval_if_<traits::is_entity, util::supersede_<handle_type>::template type, traits::component::get_reference>::template type>;
 
 		using reference = value_type;
 
 		view_iterator() : reg(nullptr), pos(-1) { }
 		view_iterator(reg_T* reg, std::size_t pos) : reg(reg), pos(pos){ }
-		view_iterator(const view_iterator& other) : reg(other.reg), pos(other.pos) { }
-		view_iterator& operator=(const view_iterator& other) { reg = other.reg; pos = other.pos;; }
-		view_iterator(view_iterator&& other) : reg(other.reg), pos(other.pos) { }
-		view_iterator& operator=(view_iterator&& other) { reg = other.reg; pos = other.pos; }
+		view_iterator(const view_iterator& other) = default; // the resolved positions and presence word are carried with the position
+		view_iterator& operator=(const view_iterator& other) = default;
+		view_iterator(view_iterator&& other) = default;
+		view_iterator& operator=(view_iterator&& other) = default;
 		
 		constexpr reference operator*() const {
 			handle_type hnd;
@@ -74,9 +169,17 @@ namespace ecs {
 					if constexpr (traits::is_entity_v<T>) {
 						return hnd;
 					} else if constexpr (util::cmp::is_ignore_const_same_v<from_type, T>) {
-						return std::ref(reg->template pool<T>().component_at(pos));
+						return make_ref(reg->template pool<T>().component_at(pos));
+					} else if constexpr (traits::is_grouped_v<sequence_policy, T>) {
+						if (pos < group_size()) {
+							return make_ref(reg->template pool<T>().component_at(pos));
+						} else {
+							return make_ref(reg->template pool<T>().component_at(resolved<T>()));
+						}
+					} else if constexpr (!std::is_void_v<traits::component::get_storage_t<std::remove_const_t<T>>>) {
+						return make_ref(reg->template pool<T>().component_at(resolved<T>()));
 					} else {
-						return std::ref(reg->template pool<T>().get_component(hnd));
+						return make_ref(reg->template pool<T>().get_component(hnd));
 					}
 				}.template operator()<Ts>()...);
 			});
@@ -107,8 +210,8 @@ namespace ecs {
 			return *this;
 		}
 
-		constexpr view_iterator operator++(int) { auto tmp = *this; ++pos; return tmp; }
-		constexpr view_iterator operator--(int) { auto tmp = *this; --pos; return tmp; }
+		constexpr view_iterator operator++(int) { auto tmp = *this; ++*this; return tmp; }
+		constexpr view_iterator operator--(int) { auto tmp = *this; --*this; return tmp; }
 
 		constexpr difference_type operator-(const view_iterator& other) const { return pos - other.pos; }
 
@@ -117,17 +220,38 @@ namespace ecs {
 
 	private:
 		bool valid() {
+			if constexpr (traits::component::get_pointer_stable_v<from_type> || std::is_same_v<sequence_policy, policy::lazy>) {
+				if (reg->template pool<from_type>().at(pos) == tombstone{}) return false;
+			}
+
+			if constexpr (presence_filtered) {
+				std::size_t key = reg->template pool<from_type>().at(pos);
+				if (std::size_t word_i = bitmap::word_index(key); word_i != cache.word_i) {
+					cache = { word_i, presence_mask(word_i) };
+				}
+				if (!(cache.word & bitmap::bit(key))) return false;
+			}
+
 			return util::apply<non_parallel_set>([&]<typename ... Ts> {
 				if constexpr (!random_access) {
 					return true;
 				} else {
 					const handle_type& hnd = reg->template pool<from_type>().at(pos);
 					return ([&]<typename T>{ 
+						if constexpr (traits::is_grouped_v<sequence_policy, T>) {
+							if (pos < group_size()) return true; // shares index with from_type
+						}
+
 						static constexpr std::size_t it_index = util::find_v<non_parallel_set, util::cmp::to_<T>::template type>;
+						auto& storage = reg->template get_attribute<traits::component::get_storage_t<T>>();
+						if (aligned<T>(hnd)) { // shares the position, see pool::sort_as
+							std::get<it_index>(its) = storage.begin() + pos;
+							return true;
+						}
+
 						auto& indexer = reg->template get_attribute<traits::component::get_indexer_t<T>>();
-						if (auto it = indexer.find(hnd); it == indexer.end()) {
-							auto& storage = reg->template get_attribute<traits::component::get_storage_t<T>>();
-							std::get<it_index>(its) = storage.at(it->second);
+						if (auto it = indexer.find(hnd); it != indexer.end()) {
+							std::get<it_index>(its) = storage.begin() + (*it).second;
 							return true;
 						} else {
 							return false;
@@ -140,9 +264,84 @@ namespace ecs {
 			});
 		}
 
+		/* returns the presence bits of the 64 entity indices of the word, cleared for entities missing a selected or included component or holding an excluded one. */
+		bitmap::word_type presence_mask(std::size_t word_i) const {
+			bitmap::word_type word = ~bitmap::word_type{ 0 };
+
+			util::apply<non_parallel_set>([&]<typename ... Ts> {
+				([&]<typename T>() {
+					if constexpr (traits::component::get_presence_bitmap_v<T>) {
+						word &= reg->template pool<T>().presence().word(word_i);
+					}
+				}.template operator()<Ts>(), ...);
+			});
+
+			util::apply<where_T>([&]<typename ... where_Ts> {
+				([&]<typename T>() {
+					if constexpr (traits::is_presence_masked<T>::value) {
+						T::mask(*reg, word_i, word);
+					}
+				}.template operator()<where_Ts>(), ...);
+			});
+
+			return word;
+		}
+
+		/* returns true if the pool of T stores the entity at the current position, avoiding the indexer lookup. only the prefix ordered by sort_as is probed. */
+		template<typename T>
+		bool aligned(const handle_type& hnd) const {
+			using manager_t = traits::component::get_manager_t<std::remove_const_t<T>>;
+			if constexpr (std::is_void_v<manager_t>) {
+				return false;
+			} else {
+				if (pos >= reg->template get_attribute<const traits::component::get_alignment_t<std::remove_const_t<T>>>()) return false;
+				const auto& manager = reg->template get_attribute<const manager_t>();
+				return pos < manager.size() && manager[pos] == hnd;
+			}
+		}
+
+		/* returns the index of the component T of the current entity, resolved by valid. */
+		template<typename T>
+		std::size_t resolved() const {
+			static constexpr std::size_t it_index = util::find_v<non_parallel_set, util::cmp::to_<T>::template type>;
+			auto& storage = reg->template get_attribute<traits::component::get_storage_t<T>>(); // the storage valid resolved the iterator from
+			return std::get<it_index>(its) - storage.begin();
+		}
+
+		/* returns the entity handle at the current position. */
+		const handle_type& get_handle() const {
+			return reg->template pool<from_type>().at(pos);
+		}
+
+		/* returns the index of the component T of the current entity, the position is shared when T is from_type. */
+		template<typename T>
+		std::size_t index_of() const {
+			if constexpr (util::cmp::is_ignore_const_same_v<from_type, T>) {
+				return pos;
+			} else {
+				return reg->template pool<T>().index_of(get_handle());
+			}
+		}
+
+		/* wraps lvalue references for std::make_tuple, proxy references are returned by value. */
+		template<typename U>
+		static constexpr auto make_ref(U&& ref) {
+			if constexpr (std::is_lvalue_reference_v<U>) {
+				return std::ref(ref);
+			} else {
+				return ref;
+			}
+		}
+
+		/* returns the number of entities packed at the front of each pool grouped with from_type. */
+		std::size_t group_size() const {
+			return reg->template get_attribute<const traits::component::get_group_t<from_type>>();
+		}
+
 		reg_T* reg;
 		std::size_t pos;
 		[[no_unique_address]] non_parallel_iterators its;
+		[[no_unique_address]] std::conditional_t<presence_filtered, presence_cache, std::monostate> cache; // the presence word is recomputed when the word index changes
 	};
 
 	template<typename select_T, typename from_T, typename where_T, typename reg_T>